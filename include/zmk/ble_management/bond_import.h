@@ -0,0 +1,33 @@
+/**
+ * BLE Management Feature - Out-of-band bond import
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/addr.h>
+
+#define ZMK_BLE_MGMT_BOND_KEY_SIZE 16
+
+/**
+ * Keys of an LE Secure Connections bond generated off the keyboard
+ */
+struct zmk_ble_mgmt_bond {
+    bt_addr_le_t addr;  // Identity address of the host
+    uint8_t ltk[ZMK_BLE_MGMT_BOND_KEY_SIZE];
+    uint8_t irk[ZMK_BLE_MGMT_BOND_KEY_SIZE];
+    bool has_irk;        // The host uses resolvable private addresses
+    bool authenticated;  // Keys come from an MITM protected pairing
+};
+
+/**
+ * Install a bond into a profile slot, replacing any bond of the slot. The
+ * keys are persisted and usable as soon as this returns.
+ *
+ * Returns -EINVAL for a bad slot or an address that is not an identity
+ * address, -EEXIST if another profile is bonded to the host and -ENOMEM if
+ * the key table is full.
+ */
+int zmk_ble_mgmt_bond_import(uint8_t index,
+                             const struct zmk_ble_mgmt_bond *bond);
@@ -0,0 +1,56 @@
+/**
+ * BLE Management Feature - Boot-time profiling
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+enum zmk_ble_mgmt_boot_milestone {
+    ZMK_BLE_MGMT_BOOT_INIT,                   // Module init (SYS_INIT) ran
+    ZMK_BLE_MGMT_BOOT_SETTINGS_LOAD_START,    // Load including ble_mgmt began
+    ZMK_BLE_MGMT_BOOT_SETTINGS_FIRST_RECORD,  // First ble_mgmt record loaded
+    ZMK_BLE_MGMT_BOOT_SETTINGS_COMMIT,        // Settings load of ble_mgmt done
+    ZMK_BLE_MGMT_BOOT_FIRST_ADV,
+    ZMK_BLE_MGMT_BOOT_FIRST_CONNECT,
+    ZMK_BLE_MGMT_BOOT_MILESTONE_COUNT,
+};
+
+/**
+ * Boot milestones in us since boot (0 = not reached yet) and the cost of
+ * loading ble_mgmt settings records. Milestones are 64-bit since a deferred
+ * settings load or the first connection can come long after boot.
+ */
+struct zmk_ble_mgmt_boot_profile {
+    uint64_t milestones_us[ZMK_BLE_MGMT_BOOT_MILESTONE_COUNT];
+    uint32_t init_us;  // Time spent in module init
+    uint32_t records;  // ble_mgmt settings records parsed
+    uint32_t record_total_us;
+    uint32_t record_max_us;
+};
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_BOOT_PROFILE)
+/**
+ * Record the first time a milestone is reached.
+ */
+void zmk_ble_mgmt_boot_profile_mark(enum zmk_ble_mgmt_boot_milestone milestone);
+
+/**
+ * Time a section (module init or parsing one settings record) using the
+ * cycle counter value returned by zmk_ble_mgmt_boot_profile_begin().
+ */
+static inline uint32_t zmk_ble_mgmt_boot_profile_begin(void) {
+    return k_cycle_get_32();
+}
+void zmk_ble_mgmt_boot_profile_init_done(uint32_t begin);
+void zmk_ble_mgmt_boot_profile_record_done(uint32_t begin);
+
+int zmk_ble_mgmt_boot_profile_get(struct zmk_ble_mgmt_boot_profile *profile);
+#else
+static inline void
+zmk_ble_mgmt_boot_profile_mark(enum zmk_ble_mgmt_boot_milestone milestone) {}
+static inline uint32_t zmk_ble_mgmt_boot_profile_begin(void) { return 0; }
+static inline void zmk_ble_mgmt_boot_profile_init_done(uint32_t begin) {}
+static inline void zmk_ble_mgmt_boot_profile_record_done(uint32_t begin) {}
+#endif
@@ -0,0 +1,30 @@
+/**
+ * BLE Management Feature - Bluetooth stack buffer utilization monitor
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Occupancy of one net_buf pool, sampled periodically while a connection is
+ * up and the keyboard is active.
+ */
+struct zmk_ble_mgmt_buf_pool_usage {
+    const char *name;
+    uint16_t size;      // Total number of buffers in the pool
+    uint16_t used;      // Buffers in use at the last sample
+    uint16_t max_used;  // High-watermark since boot or the last reset
+};
+
+/**
+ * Sample every pool now, e.g. before reading the usage outside the periodic
+ * sampling.
+ */
+void zmk_ble_mgmt_buf_monitor_sample(void);
+
+size_t zmk_ble_mgmt_buf_monitor_count(void);
+int zmk_ble_mgmt_buf_monitor_get(size_t index,
+                                 struct zmk_ble_mgmt_buf_pool_usage *usage);
+void zmk_ble_mgmt_buf_monitor_reset(void);
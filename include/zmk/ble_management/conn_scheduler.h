@@ -0,0 +1,38 @@
+/**
+ * BLE Management Feature - Activity-adaptive connection interval scheduler
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Per-profile scheduler thresholds.
+ *
+ * Intervals are in units of 1.25 ms as used by the BLE specification.
+ */
+struct zmk_ble_mgmt_conn_sched_config {
+    uint32_t idle_timeout_ms;
+    uint16_t fast_interval;
+    uint16_t slow_interval;
+    uint16_t slow_latency;
+};
+
+/**
+ * Per-profile statistics on how long each mode was active.
+ */
+struct zmk_ble_mgmt_conn_sched_stats {
+    uint32_t fast_ms;
+    uint32_t slow_ms;
+    uint32_t fast_requests;
+    uint32_t slow_requests;
+    bool fast_active;
+};
+
+int zmk_ble_mgmt_conn_sched_get_config(
+    uint8_t profile, struct zmk_ble_mgmt_conn_sched_config *config);
+int zmk_ble_mgmt_conn_sched_set_config(
+    uint8_t profile, const struct zmk_ble_mgmt_conn_sched_config *config);
+int zmk_ble_mgmt_conn_sched_get_stats(
+    uint8_t profile, struct zmk_ble_mgmt_conn_sched_stats *stats);
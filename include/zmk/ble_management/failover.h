@@ -0,0 +1,24 @@
+/**
+ * BLE Management Feature - Link-loss failover tracking between BLE and USB
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Failover statistics since boot.
+ *
+ * A gap is the time from losing the transport in use until reports can flow
+ * again, either over the other transport or over the recovered link.
+ */
+struct zmk_ble_mgmt_failover_stats {
+    uint32_t failovers;     // Switches away from a lost transport
+    uint32_t failbacks;     // Switches back to the preferred transport
+    uint32_t gaps;          // Number of completed gaps
+    uint32_t last_gap_ms;
+    uint32_t max_gap_ms;
+    uint32_t total_gap_ms;
+};
+
+int zmk_ble_mgmt_failover_get_stats(struct zmk_ble_mgmt_failover_stats *stats);
@@ -0,0 +1,24 @@
+/**
+ * BLE Management Feature - Deferred loading of ble_mgmt settings
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_LAZY_SETTINGS)
+/**
+ * Whether ble_mgmt records seen now should be skipped because loading of the
+ * subtree is deferred. Settings handlers return early while this is true.
+ */
+bool zmk_ble_mgmt_settings_deferred(void);
+
+/**
+ * Load the ble_mgmt subtree now if it has not been loaded yet, or wait for
+ * a load in progress to finish.
+ */
+void zmk_ble_mgmt_settings_ensure_loaded(void);
+#else
+static inline bool zmk_ble_mgmt_settings_deferred(void) { return false; }
+static inline void zmk_ble_mgmt_settings_ensure_loaded(void) {}
+#endif
@@ -0,0 +1,130 @@
+/**
+ * BLE Management Feature - Metrics registry
+ *
+ * Counters, gauges and histograms defined anywhere in the module with the
+ * macros below land in one iterable section, in the order of their
+ * identifiers. GetMetricsSchema describes them and GetMetrics returns their
+ * values as one compact dump, so a new metric needs no protocol change.
+ * Without CONFIG_ZMK_BLE_MANAGEMENT_METRICS the macros compile to nothing.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
+
+#define ZMK_BLE_MGMT_METRIC_MAX_BUCKETS 16
+
+// Longest name including the NUL (MetricInfo.name max_size in
+// ble_management.options)
+#define ZMK_BLE_MGMT_METRIC_NAME_MAX 24
+
+// Largest dump of one metric: a 5 byte varint per bucket
+#define ZMK_BLE_MGMT_METRIC_MAX_SIZE (ZMK_BLE_MGMT_METRIC_MAX_BUCKETS * 5)
+
+enum zmk_ble_mgmt_metric_type {
+    ZMK_BLE_MGMT_METRIC_COUNTER,
+    ZMK_BLE_MGMT_METRIC_GAUGE,
+    ZMK_BLE_MGMT_METRIC_HISTOGRAM,
+};
+
+struct zmk_ble_mgmt_metric {
+    const char *name;
+    enum zmk_ble_mgmt_metric_type type;  // Gauges hold signed values
+    // Histograms: upper bounds (exclusive) of the buckets; the last bucket
+    // counts everything above the previous bound
+    const uint32_t *bounds;
+    uint8_t buckets;
+    atomic_t *values;  // One per bucket, or a single value
+};
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_METRICS)
+
+#define Z_BLE_MGMT_METRIC_DEFINE(_id, _name, _type, _bounds, _buckets)         \
+    BUILD_ASSERT(sizeof(_name) <= ZMK_BLE_MGMT_METRIC_NAME_MAX,                \
+                 "Metric name " _name " is too long");                         \
+    static atomic_t                                                            \
+        _CONCAT(_zmk_ble_mgmt_metric_values_, _id)[MAX(_buckets, 1)];          \
+    const STRUCT_SECTION_ITERABLE(zmk_ble_mgmt_metric, _id) = {                \
+        .name    = _name,                                                      \
+        .type    = _type,                                                      \
+        .bounds  = _bounds,                                                    \
+        .buckets = _buckets,                                                   \
+        .values  = _CONCAT(_zmk_ble_mgmt_metric_values_, _id),                 \
+    }
+
+#define ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(_id, _name)                         \
+    Z_BLE_MGMT_METRIC_DEFINE(_id, _name, ZMK_BLE_MGMT_METRIC_COUNTER, NULL, 0)
+
+#define ZMK_BLE_MGMT_METRIC_GAUGE_DEFINE(_id, _name)                           \
+    Z_BLE_MGMT_METRIC_DEFINE(_id, _name, ZMK_BLE_MGMT_METRIC_GAUGE, NULL, 0)
+
+/**
+ * The bucket bounds follow the name, e.g.
+ *   ZMK_BLE_MGMT_METRIC_HISTOGRAM_DEFINE(rpc_us, "rpc_us", 100, 1000,
+ *                                        UINT32_MAX);
+ */
+#define ZMK_BLE_MGMT_METRIC_HISTOGRAM_DEFINE(_id, _name, ...)                  \
+    static const uint32_t _CONCAT(_zmk_ble_mgmt_metric_bounds_, _id)[] = {     \
+        __VA_ARGS__};                                                          \
+    BUILD_ASSERT(ARRAY_SIZE(_CONCAT(_zmk_ble_mgmt_metric_bounds_, _id)) <=     \
+                     ZMK_BLE_MGMT_METRIC_MAX_BUCKETS,                          \
+                 "Too many buckets for metric " _name);                        \
+    Z_BLE_MGMT_METRIC_DEFINE(                                                  \
+        _id, _name, ZMK_BLE_MGMT_METRIC_HISTOGRAM,                             \
+        _CONCAT(_zmk_ble_mgmt_metric_bounds_, _id),                            \
+        ARRAY_SIZE(_CONCAT(_zmk_ble_mgmt_metric_bounds_, _id)))
+
+#define ZMK_BLE_MGMT_METRIC_DECLARE(_id)                                       \
+    extern const struct zmk_ble_mgmt_metric _id
+
+#define ZMK_BLE_MGMT_METRIC_ADD(_id, _n) atomic_add((_id).values, (_n))
+#define ZMK_BLE_MGMT_METRIC_INC(_id)     ZMK_BLE_MGMT_METRIC_ADD(_id, 1)
+#define ZMK_BLE_MGMT_METRIC_SET(_id, _v) atomic_set((_id).values, (_v))
+#define ZMK_BLE_MGMT_METRIC_OBSERVE(_id, _v)                                   \
+    zmk_ble_mgmt_metric_observe(&(_id), (_v))
+
+void zmk_ble_mgmt_metric_observe(const struct zmk_ble_mgmt_metric *metric,
+                                 uint32_t value);
+
+/**
+ * Number of registered metrics and the metric at a schema index
+ */
+size_t zmk_ble_mgmt_metrics_count(void);
+const struct zmk_ble_mgmt_metric *zmk_ble_mgmt_metrics_get(size_t index);
+
+/**
+ * Hash of every name, type and bucket bound. Hosts can cache the schema
+ * for as long as it does not change.
+ */
+uint32_t zmk_ble_mgmt_metrics_schema_id(void);
+
+/**
+ * Write the values of the metrics from index first on as LEB128 varints,
+ * one per value in schema order. Gauges are zigzag encoded so negative
+ * values stay short; counters and histogram buckets are unsigned. Metrics
+ * are not split; as many as fit in size are written. size must be at least
+ * ZMK_BLE_MGMT_METRIC_MAX_SIZE so that every call makes progress.
+ *
+ * Returns the index of the first metric left out (the count when all were
+ * written) and stores the bytes used in len.
+ */
+size_t zmk_ble_mgmt_metrics_dump(size_t first, uint8_t *buf, size_t size,
+                                 size_t *len);
+
+#else
+
+#define ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(_id, _name)
+#define ZMK_BLE_MGMT_METRIC_GAUGE_DEFINE(_id, _name)
+#define ZMK_BLE_MGMT_METRIC_HISTOGRAM_DEFINE(_id, _name, ...)
+#define ZMK_BLE_MGMT_METRIC_DECLARE(_id)
+#define ZMK_BLE_MGMT_METRIC_ADD(_id, _n)     ((void)(_n))
+#define ZMK_BLE_MGMT_METRIC_INC(_id)         ((void)0)
+#define ZMK_BLE_MGMT_METRIC_SET(_id, _v)     ((void)(_v))
+#define ZMK_BLE_MGMT_METRIC_OBSERVE(_id, _v) ((void)(_v))
+
+#endif
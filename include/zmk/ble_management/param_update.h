@@ -0,0 +1,41 @@
+/**
+ * BLE Management Feature - Connection parameter update tracking
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/bluetooth/conn.h>
+
+/**
+ * Per-profile outcome counters of connection parameter update requests.
+ */
+struct zmk_ble_mgmt_param_update_stats {
+    uint32_t attempts;  // Requests made (retries not included)
+    uint32_t accepted;  // Host applied the requested parameters
+    uint32_t rejected;  // Host applied different parameters
+    uint32_t ignored;   // No update after all retries timed out
+    uint32_t retries;
+    uint16_t last_interval;  // Parameters of the last update from the host
+    uint16_t last_latency;
+    uint16_t last_timeout;
+};
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PARAM_UPDATE)
+/**
+ * Request connection parameters, retrying with exponential backoff until the
+ * host applies an update or the retry limit is reached.
+ *
+ * Returns -EBUSY while an earlier request on the same profile is followed,
+ * and -EALREADY when the parameters are already in effect.
+ */
+int zmk_ble_mgmt_param_update_request(struct bt_conn *conn,
+                                      const struct bt_le_conn_param *param);
+int zmk_ble_mgmt_param_update_get_stats(
+    uint8_t profile, struct zmk_ble_mgmt_param_update_stats *stats);
+#else
+static inline int zmk_ble_mgmt_param_update_request(
+    struct bt_conn *conn, const struct bt_le_conn_param *param) {
+    return bt_conn_le_param_update(conn, param);
+}
+#endif
@@ -0,0 +1,47 @@
+/**
+ * BLE Management Feature - Profile helpers shared by the module sources
+ */
+
+#pragma once
+
+#include <zephyr/bluetooth/addr.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zmk/ble.h>
+
+/**
+ * Find the profile slot bonded to the given address.
+ *
+ * Returns the profile index, or -ENOENT if no profile uses the address.
+ */
+static inline int zmk_ble_mgmt_profile_index(const bt_addr_le_t *addr) {
+    if (!addr) {
+        return -EINVAL;
+    }
+
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        bt_addr_le_t *profile_addr = zmk_ble_profile_address(i);
+        if (profile_addr && bt_addr_le_eq(profile_addr, addr)) {
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+/**
+ * Look up the connection of a profile slot.
+ *
+ * Returns a new reference that must be released with bt_conn_unref(), or NULL
+ * if the profile is open or not connected.
+ */
+static inline struct bt_conn *zmk_ble_mgmt_profile_conn(uint8_t index) {
+    if (index >= ZMK_BLE_PROFILE_COUNT) {
+        return NULL;
+    }
+
+    bt_addr_le_t *addr = zmk_ble_profile_address(index);
+    if (!addr || bt_addr_le_eq(addr, BT_ADDR_LE_ANY) ||
+        bt_addr_le_eq(addr, BT_ADDR_LE_NONE)) {
+        return NULL;
+    }
+    return bt_conn_lookup_addr_le(BT_ID_DEFAULT, addr);
+}
@@ -0,0 +1,66 @@
+/**
+ * BLE Management Feature - Factory provisioning cycles
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/conn.h>
+
+enum zmk_ble_mgmt_provisioning_step {
+    ZMK_BLE_MGMT_PROVISIONING_CONNECT,  // Profile opened until connected
+    ZMK_BLE_MGMT_PROVISIONING_PAIR,     // Connected until bonded
+    ZMK_BLE_MGMT_PROVISIONING_VERIFY,   // Bonded until a report is accepted
+    ZMK_BLE_MGMT_PROVISIONING_UNPAIR,   // Verified until disconnected
+    ZMK_BLE_MGMT_PROVISIONING_STEP_COUNT,
+};
+
+// No step in progress / no step failed
+#define ZMK_BLE_MGMT_PROVISIONING_NONE ZMK_BLE_MGMT_PROVISIONING_STEP_COUNT
+
+/**
+ * Durations in ms of every completed step of the current run, including
+ * those of cycles that failed in a later step
+ */
+struct zmk_ble_mgmt_provisioning_step_stats {
+    uint32_t count;
+    uint32_t last_ms;
+    uint32_t min_ms;
+    uint32_t max_ms;
+    uint32_t total_ms;
+};
+
+struct zmk_ble_mgmt_provisioning_status {
+    bool running;
+    uint8_t profile;
+    enum zmk_ble_mgmt_provisioning_step step;  // In progress
+    uint32_t cycles_requested;
+    uint32_t cycles_passed;
+    uint32_t cycles_failed;
+    enum zmk_ble_mgmt_provisioning_step last_failed_step;
+    uint32_t last_cycle_ms;  // Duration of the last passed cycle
+    uint32_t elapsed_ms;     // Since the run started, until it ended
+    struct zmk_ble_mgmt_provisioning_step_stats
+        steps[ZMK_BLE_MGMT_PROVISIONING_STEP_COUNT];
+};
+
+/**
+ * Run the given number of pair, verify and unpair cycles on a profile.
+ * Any bond of the profile is removed first. Returns -EBUSY while a run is
+ * in progress.
+ */
+int zmk_ble_mgmt_provisioning_start(uint8_t profile, uint32_t cycles);
+
+/**
+ * Abort the run; the profile is left open.
+ */
+int zmk_ble_mgmt_provisioning_stop(void);
+
+int zmk_ble_mgmt_provisioning_get_status(
+    struct zmk_ble_mgmt_provisioning_status *status);
+
+/**
+ * Called by the GATT notify hook with the result of every notification.
+ */
+void zmk_ble_mgmt_provisioning_on_notify(struct bt_conn *conn, int rc);
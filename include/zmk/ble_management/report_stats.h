@@ -0,0 +1,35 @@
+/**
+ * BLE Management Feature - HID report delivery statistics
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zmk/endpoints_types.h>
+
+struct bt_conn;
+struct bt_gatt_notify_params;
+
+/**
+ * Delivery counters for one transport (USB) or one BLE profile.
+ */
+struct zmk_ble_mgmt_report_stats {
+    uint32_t sent;           // Reports accepted by the transport
+    uint32_t failed;         // Reports rejected by the transport
+    uint32_t notify_failed;  // GATT notifications that failed to send
+    uint32_t no_buffer;      // GATT notifications dropped for lack of buffers
+};
+
+int zmk_ble_mgmt_report_stats_get_usb(struct zmk_ble_mgmt_report_stats *stats);
+int zmk_ble_mgmt_report_stats_get_ble(uint8_t profile,
+                                      struct zmk_ble_mgmt_report_stats *stats);
+void zmk_ble_mgmt_report_stats_reset(void);
+
+/**
+ * Called by the link-time hooks with the result of a report send and of a
+ * GATT notification.
+ */
+void zmk_ble_mgmt_report_stats_on_send(
+    const struct zmk_endpoint_instance *endpoint, int rc);
+void zmk_ble_mgmt_report_stats_on_notify(
+    struct bt_conn *conn, const struct bt_gatt_notify_params *params, int rc);
@@ -0,0 +1,73 @@
+/**
+ * BLE Management Feature - Settings write accounting and wear budget
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/ble_management/tracing.h>
+
+/**
+ * Key classes of the ble_mgmt settings subtree.
+ */
+enum zmk_ble_mgmt_settings_class {
+    ZMK_BLE_MGMT_SETTINGS_NAME,        // ble_mgmt/name/<addr>
+    ZMK_BLE_MGMT_SETTINGS_SCHED,       // ble_mgmt/sched/<idx>
+    ZMK_BLE_MGMT_SETTINGS_STO,         // ble_mgmt/sto/<idx>
+    ZMK_BLE_MGMT_SETTINGS_SPLIT_LINK,  // ble_mgmt/split_link/<slot>
+    ZMK_BLE_MGMT_SETTINGS_OTHER,
+    ZMK_BLE_MGMT_SETTINGS_CLASS_COUNT,
+};
+
+struct zmk_ble_mgmt_settings_class_stats {
+    uint32_t writes;        // Saves and deletes since boot
+    uint32_t bytes;         // Value bytes written since boot
+    uint32_t rate_limited;  // Saves refused by the rate limit since boot
+};
+
+/**
+ * Write volume and endurance estimate of the storage partition.
+ */
+struct zmk_ble_mgmt_settings_wear {
+    struct zmk_ble_mgmt_settings_class_stats
+        classes[ZMK_BLE_MGMT_SETTINGS_CLASS_COUNT];
+    uint32_t lifetime_flash_bytes;  // Estimated flash bytes incl. overhead
+    uint32_t partition_size;        // 0 if the storage partition is unknown
+    uint32_t remaining_permille;    // Estimated endurance left, 1000 = new
+    uint32_t tokens;                // Saves currently allowed by rate limit
+};
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR)
+/**
+ * settings_save_one() with accounting and rate limiting.
+ *
+ * Returns -EBUSY without writing when the rate limit is exhausted, so
+ * callers save before changing their state in RAM.
+ */
+int zmk_ble_mgmt_settings_save(const char *name, const void *value,
+                               size_t len);
+
+/**
+ * settings_delete() with accounting. Deletes are never rate limited.
+ */
+int zmk_ble_mgmt_settings_delete(const char *name);
+
+int zmk_ble_mgmt_settings_wear_get(struct zmk_ble_mgmt_settings_wear *wear);
+#else
+static inline int zmk_ble_mgmt_settings_save(const char *name,
+                                             const void *value, size_t len) {
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_IN, len, 0);
+    int rc = settings_save_one(name, value, len);
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_OUT, len, rc);
+    return rc;
+}
+
+static inline int zmk_ble_mgmt_settings_delete(const char *name) {
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_IN, 0, 0);
+    int rc = settings_delete(name);
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_OUT, 0, rc);
+    return rc;
+}
+#endif
@@ -0,0 +1,54 @@
+/**
+ * BLE Management Feature - Split peripheral link parameter tuning
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Connection parameters of the link to a split peripheral.
+ *
+ * Interval is in 1.25 ms units, timeout in 10 ms units and phy a
+ * BT_GAP_LE_PHY_* value (0 keeps the PHY chosen by ZMK).
+ */
+struct zmk_ble_mgmt_split_link_params {
+    uint16_t interval;
+    uint16_t latency;
+    uint16_t timeout;
+    uint8_t phy;
+};
+
+/**
+ * Round trip time of GATT reads over the split link, in us.
+ */
+struct zmk_ble_mgmt_split_link_probe {
+    uint8_t samples;  // 0 if no probe completed
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t max_us;
+};
+
+/**
+ * Configured and live parameters of a slot and the probes taken around the
+ * last change.
+ */
+struct zmk_ble_mgmt_split_link_state {
+    bool configured;
+    struct zmk_ble_mgmt_split_link_params params;
+    bool connected;
+    struct zmk_ble_mgmt_split_link_params current;
+    struct zmk_ble_mgmt_split_link_probe before;
+    struct zmk_ble_mgmt_split_link_probe after;
+};
+
+int zmk_ble_mgmt_split_link_get(uint8_t slot,
+                                struct zmk_ble_mgmt_split_link_state *state);
+
+/**
+ * Persist and request new parameters on a slot, or return the slot to ZMK's
+ * defaults (for new connections) when params is NULL.
+ */
+int zmk_ble_mgmt_split_link_set(
+    uint8_t slot, const struct zmk_ble_mgmt_split_link_params *params);
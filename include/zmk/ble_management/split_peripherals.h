@@ -0,0 +1,60 @@
+/**
+ * BLE Management Feature - Split peripheral state on the central
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/addr.h>
+#include <zephyr/bluetooth/conn.h>
+
+#define ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT                                    \
+    CONFIG_ZMK_SPLIT_BLE_CENTRAL_PERIPHERALS
+
+/**
+ * State of one peripheral slot. Slots use ZMK's split central numbering, the
+ * same as the source of peripheral battery events.
+ */
+struct zmk_ble_mgmt_split_peripheral {
+    bt_addr_le_t addr;  // BT_ADDR_LE_ANY if no peripheral is bonded
+    bool bonded;
+    bool connected;
+    uint16_t interval;  // 1.25 ms units, valid when connected
+    uint16_t latency;
+    uint16_t timeout;  // 10 ms units
+    bool battery_known;
+    uint8_t battery_level;  // Last reported state of charge in percent
+    uint32_t reconnects;    // Connections after the first since boot
+    uint32_t disconnects;
+    uint8_t last_disconnect_reason;  // HCI reason, valid if disconnects > 0
+    uint32_t last_disconnect_age_s;  // Seconds since the last disconnect
+};
+
+int zmk_ble_mgmt_split_peripheral_get(
+    uint8_t slot, struct zmk_ble_mgmt_split_peripheral *peripheral);
+
+/**
+ * Read the address ZMK bonded to a peripheral slot.
+ * Returns -ENOENT if the slot is empty.
+ */
+int zmk_ble_mgmt_split_peripheral_addr(uint8_t slot, bt_addr_le_t *addr);
+
+/**
+ * Find the slot bonded to the given address, or -ENOENT.
+ */
+int zmk_ble_mgmt_split_peripheral_slot(const bt_addr_le_t *addr);
+
+/**
+ * Drop the cached bonded addresses after ZMK's records changed without a
+ * peripheral connecting or disconnecting, e.g. after clearing all bonds.
+ */
+void zmk_ble_mgmt_split_peripherals_invalidate(void);
+
+/**
+ * Look up the connection of a peripheral slot.
+ *
+ * Returns a new reference that must be released with bt_conn_unref(), or NULL
+ * if the slot is empty or not connected.
+ */
+struct bt_conn *zmk_ble_mgmt_split_peripheral_conn(uint8_t slot);
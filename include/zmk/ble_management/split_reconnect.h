@@ -0,0 +1,47 @@
+/**
+ * BLE Management Feature - Split reconnect timing and fast reconnect mode
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/bluetooth.h>
+
+#define ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS 10
+
+/**
+ * Reconnect timing of the split link since boot, in ms.
+ */
+struct zmk_ble_mgmt_split_reconnect_stats {
+    uint32_t boot_connect_ms;  // Boot to first split connection, 0 if none
+    uint32_t reconnects;       // Completed disconnect-to-reconnect gaps
+    uint32_t last_ms;
+    uint32_t max_ms;
+    uint32_t counts[ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS];
+};
+
+/**
+ * Upper bounds (ms, exclusive) of the histogram buckets; the last bucket
+ * counts everything above the previous bound.
+ */
+extern const uint32_t
+    zmk_ble_mgmt_split_reconnect_bounds[ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS];
+
+int zmk_ble_mgmt_split_reconnect_get_stats(
+    struct zmk_ble_mgmt_split_reconnect_stats *stats);
+
+bool zmk_ble_mgmt_split_reconnect_get_fast(void);
+int zmk_ble_mgmt_split_reconnect_set_fast(bool enabled);
+
+/**
+ * Called by the link-time hooks before ZMK starts scanning (central) or
+ * advertising (peripheral). Returns the parameters to use instead, which may
+ * be written to buf.
+ */
+const struct bt_le_scan_param *
+zmk_ble_mgmt_split_reconnect_scan_param(const struct bt_le_scan_param *param,
+                                        struct bt_le_scan_param *buf);
+const struct bt_le_adv_param *
+zmk_ble_mgmt_split_reconnect_adv_param(const struct bt_le_adv_param *param,
+                                       struct bt_le_adv_param *buf);
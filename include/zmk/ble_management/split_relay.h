@@ -0,0 +1,74 @@
+/**
+ * BLE Management Feature - Management relay to split peripherals
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/sys/util.h>
+
+// Relay service exposed by peripherals, reached by the central over the
+// split link
+#define ZMK_BLE_MGMT_SPLIT_RELAY_SERVICE_UUID                                  \
+    BT_UUID_128_ENCODE(0x7a3e0001, 0x4b2c, 0x4e8d, 0x9f51, 0x2c6d8e3b1a00)
+#define ZMK_BLE_MGMT_SPLIT_RELAY_CHAR_UUID                                     \
+    BT_UUID_128_ENCODE(0x7a3e0002, 0x4b2c, 0x4e8d, 0x9f51, 0x2c6d8e3b1a00)
+
+#define ZMK_BLE_MGMT_SPLIT_RELAY_VERSION 1
+
+// Commands written to the relay characteristic
+enum zmk_ble_mgmt_split_relay_op {
+    ZMK_BLE_MGMT_SPLIT_RELAY_OP_FORGET_BOND        = 1,
+    ZMK_BLE_MGMT_SPLIT_RELAY_OP_FAST_RECONNECT_OFF = 2,
+    ZMK_BLE_MGMT_SPLIT_RELAY_OP_FAST_RECONNECT_ON  = 3,
+};
+
+#define ZMK_BLE_MGMT_SPLIT_RELAY_BONDED         BIT(0)
+#define ZMK_BLE_MGMT_SPLIT_RELAY_FAST_RECONNECT BIT(1)
+
+/**
+ * Status read from the relay characteristic. Both halves run the same
+ * firmware on little endian cores, so the struct is sent as is.
+ */
+struct zmk_ble_mgmt_split_relay_status {
+    uint8_t version;
+    uint8_t flags;
+    uint16_t interval;  // Link to the central, 1.25 ms units
+    uint16_t latency;
+    uint16_t timeout;  // 10 ms units
+    uint32_t uptime_s;
+} __packed;
+
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+/**
+ * Read the status of the peripheral in a slot.
+ *
+ * Blocks until the peripheral answered; returns -ENOTCONN if the slot is not
+ * connected, -ENOENT if the peripheral has no relay service and -ETIMEDOUT if
+ * it did not answer in time.
+ */
+int zmk_ble_mgmt_split_relay_get_status(
+    uint8_t slot, struct zmk_ble_mgmt_split_relay_status *status);
+
+/**
+ * Return the last status read from the peripheral in a slot without
+ * blocking, with the uptime advanced to now. The status is read once after
+ * the peripheral connects and on every zmk_ble_mgmt_split_relay_get_status().
+ * Returns -ENOENT if none was read on the current connection.
+ */
+int zmk_ble_mgmt_split_relay_get_last_status(
+    uint8_t slot, struct zmk_ble_mgmt_split_relay_status *status);
+
+/**
+ * Ask the peripheral in a slot to forget its bond with the central.
+ */
+int zmk_ble_mgmt_split_relay_forget_bond(uint8_t slot);
+
+/**
+ * Switch the fast reconnect mode of the peripheral in a slot. Returns
+ * -EIO if the peripheral was built without it.
+ */
+int zmk_ble_mgmt_split_relay_set_fast_reconnect(uint8_t slot, bool enabled);
+#endif
@@ -0,0 +1,27 @@
+/**
+ * BLE Management Feature - Per-profile supervision timeout tuning
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Per-profile dead-link detection statistics.
+ */
+struct zmk_ble_mgmt_supervision_stats {
+    uint16_t current_timeout;      // Timeout in effect (10 ms units), 0 if idle
+    uint32_t timeout_disconnects;  // Disconnects caused by supervision timeout
+    uint32_t last_detect_ms;       // Last packet to disconnect, last timeout
+    uint32_t max_detect_ms;
+    uint32_t keys_at_risk;  // Timeouts with a key press inside the window
+};
+
+/**
+ * Get the configured supervision timeout of a profile in 10 ms units,
+ * or 0 if the profile uses the default negotiated by ZMK.
+ */
+uint16_t zmk_ble_mgmt_supervision_get_timeout(uint8_t profile);
+int zmk_ble_mgmt_supervision_set_timeout(uint8_t profile, uint16_t timeout);
+int zmk_ble_mgmt_supervision_get_stats(
+    uint8_t profile, struct zmk_ble_mgmt_supervision_stats *stats);
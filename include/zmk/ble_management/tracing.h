@@ -0,0 +1,44 @@
+/**
+ * BLE Management Feature - Zephyr tracing events
+ *
+ * With CONFIG_ZMK_BLE_MANAGEMENT_TRACING the module emits Zephyr named
+ * trace events (sys_trace_named_event(), the "named_event" record of the
+ * CTF format) so its work shows on the same timeline as the kernel's
+ * thread and ISR events. Otherwise the macros compile to nothing.
+ *
+ * Names are at most 19 characters, the CTF record holds 20 bytes. *_in and
+ * *_out events bracket a span; the arguments are listed per event.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// RPC payload decode: in (payload size), out (request tag, 1 if decoded)
+#define ZMK_BLE_MGMT_TRACE_RPC_DECODE_IN  "bm_rpc_decode_in"
+#define ZMK_BLE_MGMT_TRACE_RPC_DECODE_OUT "bm_rpc_decode_out"
+// RPC handler: in (request tag), out (request tag, return code)
+#define ZMK_BLE_MGMT_TRACE_RPC_CALL_IN    "bm_rpc_call_in"
+#define ZMK_BLE_MGMT_TRACE_RPC_CALL_OUT   "bm_rpc_call_out"
+// Settings write: in (value length, 0 for deletes), out (length, result)
+#define ZMK_BLE_MGMT_TRACE_SETTINGS_IN    "bm_settings_in"
+#define ZMK_BLE_MGMT_TRACE_SETTINGS_OUT   "bm_settings_out"
+// Active profile changed (profile index)
+#define ZMK_BLE_MGMT_TRACE_PROFILE        "bm_profile"
+// Connection callbacks (connection index, then error, reason, security
+// level | error << 8 or interval)
+#define ZMK_BLE_MGMT_TRACE_CONNECTED      "bm_connected"
+#define ZMK_BLE_MGMT_TRACE_DISCONNECTED   "bm_disconnected"
+#define ZMK_BLE_MGMT_TRACE_SECURITY       "bm_security"
+#define ZMK_BLE_MGMT_TRACE_PARAM_UPDATED  "bm_param_updated"
+// Key position state changed (position, 1 if pressed)
+#define ZMK_BLE_MGMT_TRACE_KEY            "bm_key"
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_TRACING)
+#include <zephyr/tracing/tracing.h>
+
+#define ZMK_BLE_MGMT_TRACE(_name, _arg0, _arg1)                                \
+    sys_trace_named_event(_name, (uint32_t)(_arg0), (uint32_t)(_arg1))
+#else
+#define ZMK_BLE_MGMT_TRACE(_name, _arg0, _arg1) ((void)(_arg0), (void)(_arg1))
+#endif
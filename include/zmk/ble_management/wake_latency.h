@@ -0,0 +1,49 @@
+/**
+ * BLE Management Feature - Wake-to-first-report latency measurement
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS 10
+
+enum zmk_ble_mgmt_wake_kind {
+    ZMK_BLE_MGMT_WAKE_BOOT,        // Cold boot
+    ZMK_BLE_MGMT_WAKE_IDLE,        // Activity resumed after idle
+    ZMK_BLE_MGMT_WAKE_DEEP_SLEEP,  // Boot caused by a low power wake
+};
+
+/**
+ * Milestones of one wake, in ms since the wake. 0 means not observed (e.g.
+ * no advertising is needed when the link survived idle). Cold boot sessions
+ * end at secured_ms, so their first_report_ms stays 0.
+ */
+struct zmk_ble_mgmt_wake_session {
+    enum zmk_ble_mgmt_wake_kind kind;
+    uint32_t adv_start_ms;
+    uint32_t connected_ms;
+    uint32_t secured_ms;
+    uint32_t first_report_ms;
+    int8_t profile;  // Profile of the first report (cold boot: of the
+                     // secured link), -1 if none yet
+};
+
+/**
+ * Upper bounds (ms, exclusive) of the histogram buckets; the last bucket
+ * counts everything above the previous bound. Cold boots are not counted.
+ */
+extern const uint32_t
+    zmk_ble_mgmt_wake_latency_bounds[ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS];
+
+int zmk_ble_mgmt_wake_latency_get_last(
+    struct zmk_ble_mgmt_wake_session *session);
+int zmk_ble_mgmt_wake_latency_get_histogram(
+    uint8_t profile, uint32_t counts[ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS]);
+
+/**
+ * Called by the link-time hooks when advertising started and when a report
+ * was sent over BLE.
+ */
+void zmk_ble_mgmt_wake_latency_adv_started(void);
+void zmk_ble_mgmt_wake_latency_report_sent(uint8_t profile);
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""Decode the BLEM metric lines of CONFIG_ZMK_BLE_MANAGEMENT_METRICS_LOG.
+
+Reads a log (a file, or stdin when none is given, e.g. piped from a serial
+terminal or the RTT viewer) and prints one record per emission:
+
+  P <uptime_ms> <active> <states>        profile state, o/b/c per profile
+  S <schema_id> <first> <name>:<type>[:<bound>,...] ...
+                                         metrics from <first> on
+  V <schema_id> <first> <hex>            GetMetrics dump from metric <first>
+
+Log prefixes before "BLEM" are ignored. Values are only decoded once the
+schema lines with the same id have described every metric they cover;
+emissions without one are skipped and reported on stderr.
+
+  python3 scripts/metrics_log.py [--json] [log]
+"""
+
+import argparse
+import json
+import re
+import sys
+from dataclasses import dataclass, field
+
+LINE = re.compile(r"BLEM (\d+) ([PSV]) (.*)$")
+TYPES = {"c": "counter", "g": "gauge", "h": "histogram"}
+
+
+@dataclass
+class Metric:
+    name: str
+    type: str
+    bounds: list[int]
+
+    @property
+    def values(self) -> int:
+        return len(self.bounds) if self.type == "histogram" else 1
+
+
+@dataclass
+class Emission:
+    seq: int
+    uptime_ms: int | None = None
+    active: int | None = None
+    profiles: str = ""
+    schema_id: str | None = None
+    chunks: dict[int, bytes] = field(default_factory=dict)
+
+
+def decode_varints(data: bytes) -> list[int]:
+    values, value, shift = [], 0, 0
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            values.append(value)
+            value, shift = 0, 0
+    if shift:
+        raise ValueError("truncated varint")
+    return values
+
+
+def decode(emission: Emission, schema: dict[int, Metric]) -> dict:
+    metrics: dict[str, int | dict[str, int]] = {}
+    for first, data in sorted(emission.chunks.items()):
+        values = decode_varints(data)
+        index = first
+        while values:
+            metric = schema.get(index)
+            if metric is None:
+                raise ValueError(f"no schema for metric {index}")
+            taken, values = values[:metric.values], values[metric.values:]
+            if metric.type == "histogram":
+                metrics[metric.name] = {
+                    f"<{bound}": count
+                    for bound, count in zip(metric.bounds, taken)}
+            elif metric.type == "gauge":
+                # Zigzag encoded
+                metrics[metric.name] = (taken[0] >> 1) ^ -(taken[0] & 1)
+            else:
+                metrics[metric.name] = taken[0]
+            index += 1
+    return {
+        "seq": emission.seq,
+        "uptime_ms": emission.uptime_ms,
+        "active": emission.active,
+        "profiles": emission.profiles,
+        "metrics": metrics,
+    }
+
+
+def format_record(record: dict) -> str:
+    parts = [f"seq={record['seq']}", f"t={record['uptime_ms']}",
+             f"active={record['active']}", f"profiles={record['profiles']}"]
+    for name, value in record["metrics"].items():
+        if isinstance(value, dict):
+            value = "/".join(str(count) for count in value.values())
+        parts.append(f"{name}={value}")
+    return " ".join(parts)
+
+
+def parse(lines, emit) -> None:
+    schemas: dict[str, dict[int, Metric]] = {}
+    current: Emission | None = None
+
+    def flush() -> None:
+        if current is None or current.schema_id is None:
+            return
+        schema = schemas.get(current.schema_id)
+        if schema is None:
+            print(f"seq {current.seq}: no schema {current.schema_id} yet",
+                  file=sys.stderr)
+            return
+        try:
+            emit(decode(current, schema))
+        except ValueError as e:
+            print(f"seq {current.seq}: {e}", file=sys.stderr)
+
+    for line in lines:
+        match = LINE.search(line.rstrip())
+        if not match:
+            continue
+        seq, kind, rest = int(match[1]), match[2], match[3].split()
+        if current is None or current.seq != seq:
+            flush()
+            current = Emission(seq)
+
+        if kind == "P":
+            current.uptime_ms, current.active = int(rest[0]), int(rest[1])
+            current.profiles = rest[2]
+        elif kind == "S":
+            schema = schemas.setdefault(rest[0], {})
+            for index, entry in enumerate(rest[2:], int(rest[1])):
+                name, type_, *bounds = entry.split(":")
+                schema[index] = Metric(
+                    name, TYPES[type_],
+                    [int(b) for b in bounds[0].split(",")] if bounds else [])
+        else:
+            current.schema_id = rest[0]
+            current.chunks[int(rest[1])] = bytes.fromhex(
+                rest[2] if len(rest) > 2 else "")
+    flush()
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", help="Log file (default: stdin)")
+    parser.add_argument("--json", action="store_true",
+                        help="Print one JSON object per emission")
+    args = parser.parse_args()
+
+    def emit(record: dict) -> None:
+        print(json.dumps(record) if args.json else format_record(record),
+              flush=True)
+
+    if args.log:
+        with open(args.log, errors="replace") as log:
+            parse(log, emit)
+    else:
+        parse(sys.stdin, emit)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
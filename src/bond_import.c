@@ -0,0 +1,126 @@
+/**
+ * BLE Management Feature - Out-of-band bond import
+ *
+ * Installs pre-generated LE Secure Connections keys for a host into a
+ * profile slot so the host connects encrypted without a pairing dialog.
+ * Neither Zephyr nor ZMK have a public API for this:
+ * - the keys go into the host's key table (subsys/bluetooth/host/keys.h),
+ *   are added to the resolving list the way the host does when it loads
+ *   keys from settings and are persisted by bt_keys_store()
+ * - the profile slot is updated in place through zmk_ble_profile_address()
+ *   and saved under ZMK's own "ble/profiles/<index>" key, as ZMK does once
+ *   pairing completes
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/bluetooth/addr.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/ble.h>
+#include <zmk/ble/profile.h>
+#include <zmk/ble_management/bond_import.h>
+#include <zmk/ble_management/profiles.h>
+#include <zmk/events/ble_active_profile_changed.h>
+
+// Zephyr host internals, see CMakeLists.txt
+#include <id.h>
+#include <keys.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// LE Secure Connections keys always use the full key size
+#define ENC_KEY_SIZE 16
+
+static int set_profile_address(uint8_t index, const bt_addr_le_t *addr) {
+    bt_addr_le_t *peer = zmk_ble_profile_address(index);
+    if (!peer) {
+        return -EINVAL;
+    }
+    bt_addr_le_copy(peer, addr);
+
+    struct zmk_ble_profile *profile =
+        CONTAINER_OF(peer, struct zmk_ble_profile, peer);
+    char key[32];
+    snprintf(key, sizeof(key), "ble/profiles/%d", index);
+    int rc = settings_save_one(key, profile, sizeof(*profile));
+
+    // Lets listeners such as displays show the slot as bonded
+    if (index == zmk_ble_active_profile_index()) {
+        raise_zmk_ble_active_profile_changed(
+            (struct zmk_ble_active_profile_changed){
+                .index   = index,
+                .profile = profile,
+            });
+    }
+    return rc;
+}
+
+int zmk_ble_mgmt_bond_import(uint8_t index,
+                             const struct zmk_ble_mgmt_bond *bond) {
+    if (index >= ZMK_BLE_PROFILE_COUNT || !bond) {
+        return -EINVAL;
+    }
+
+    // A resolvable or non-resolvable private address changes over time;
+    // bonds are kept by identity address
+    if (bond->addr.type == BT_ADDR_LE_RANDOM &&
+        !BT_ADDR_IS_STATIC(&bond->addr.a)) {
+        return -EINVAL;
+    }
+
+    int other = zmk_ble_mgmt_profile_index(&bond->addr);
+    if (other >= 0 && other != index) {
+        return -EEXIST;
+    }
+
+    // Drop the bond of the slot the way UnpairProfile does
+    if (!zmk_ble_profile_is_open(index)) {
+        int active = zmk_ble_active_profile_index();
+        zmk_ble_prof_select(index);
+        zmk_ble_clear_bonds();
+        zmk_ble_prof_select(active);
+    }
+
+    struct bt_keys *keys = bt_keys_get_addr(BT_ID_DEFAULT, &bond->addr);
+    if (!keys) {
+        return -ENOMEM;
+    }
+
+    keys->enc_size = ENC_KEY_SIZE;
+    keys->flags    = BT_KEYS_SC;
+    if (bond->authenticated) {
+        keys->flags |= BT_KEYS_AUTHENTICATED;
+    }
+    memset(&keys->ltk, 0, sizeof(keys->ltk));
+    memcpy(keys->ltk.val, bond->ltk, sizeof(keys->ltk.val));
+    bt_keys_add_type(keys, BT_KEYS_LTK_P256);
+
+    if (bond->has_irk) {
+        memcpy(keys->irk.val, bond->irk, sizeof(keys->irk.val));
+        bt_keys_add_type(keys, BT_KEYS_IRK);
+    }
+
+    // Same selection as the host's keys_commit() after loading settings
+    if (bond->has_irk || !IS_ENABLED(CONFIG_BT_CENTRAL) ||
+        !IS_ENABLED(CONFIG_BT_PRIVACY)) {
+        bt_id_add(keys);
+    }
+
+    int rc = bt_keys_store(keys);
+    if (rc < 0) {
+        bt_keys_clear(keys);
+        return rc;
+    }
+
+    rc = set_profile_address(index, &bond->addr);
+    if (rc < 0) {
+        LOG_WRN("Failed to save profile %d: %d", index, rc);
+        return rc;
+    }
+
+    LOG_INF("Imported bond into profile %d", index);
+    return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * BLE Management Feature - Boot-time profiling
+ *
+ * Records when boot milestones are first reached (module init, start and
+ * end of the settings load that includes ble_mgmt, first advertising, first
+ * connection) and
+ * how long each ble_mgmt settings record took to parse, to find what delays
+ * cold boot on keyboards that power-cycle often.
+ */
+
+#include <zephyr/kernel.h>
+#include <zmk/ble_management/boot_profile.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zephyr/bluetooth/conn.h>
+#endif
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+static struct zmk_ble_mgmt_boot_profile boot_profile;
+
+void zmk_ble_mgmt_boot_profile_mark(enum zmk_ble_mgmt_boot_milestone milestone) {
+    if (milestone >= ZMK_BLE_MGMT_BOOT_MILESTONE_COUNT ||
+        boot_profile.milestones_us[milestone] != 0) {
+        return;
+    }
+
+    uint64_t now = k_ticks_to_us_floor64(k_uptime_ticks());
+    // Keep 0 reserved for milestones that were not reached
+    boot_profile.milestones_us[milestone] = MAX(now, 1);
+    LOG_DBG("Boot milestone %d at %llu us", milestone, now);
+}
+
+void zmk_ble_mgmt_boot_profile_init_done(uint32_t begin) {
+    boot_profile.init_us = k_cyc_to_us_floor32(k_cycle_get_32() - begin);
+    zmk_ble_mgmt_boot_profile_mark(ZMK_BLE_MGMT_BOOT_INIT);
+}
+
+void zmk_ble_mgmt_boot_profile_record_done(uint32_t begin) {
+    uint32_t elapsed = k_cyc_to_us_floor32(k_cycle_get_32() - begin);
+
+    boot_profile.records++;
+    boot_profile.record_total_us += elapsed;
+    if (elapsed > boot_profile.record_max_us) {
+        boot_profile.record_max_us = elapsed;
+    }
+    zmk_ble_mgmt_boot_profile_mark(ZMK_BLE_MGMT_BOOT_SETTINGS_FIRST_RECORD);
+}
+
+int zmk_ble_mgmt_boot_profile_get(struct zmk_ble_mgmt_boot_profile *profile) {
+    if (!profile) {
+        return -EINVAL;
+    }
+
+    *profile = boot_profile;
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+static void boot_profile_connected(struct bt_conn *conn, uint8_t err) {
+    if (!err) {
+        zmk_ble_mgmt_boot_profile_mark(ZMK_BLE_MGMT_BOOT_FIRST_CONNECT);
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_boot_profile_conn_cb) = {
+    .connected = boot_profile_connected,
+};
+#endif
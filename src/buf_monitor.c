@@ -0,0 +1,132 @@
+/**
+ * BLE Management Feature - Bluetooth stack buffer utilization monitor
+ *
+ * Samples the occupancy of every net_buf pool (HCI command/event, ACL TX/RX,
+ * fragments, ...) and keeps a high-watermark per pool, so pool sizes such as
+ * CONFIG_BT_BUF_ACL_TX_COUNT can be chosen from field data. The pools only
+ * fill up while there is traffic, so the timer only runs while a connection
+ * is up and the keyboard is active; readers take a fresh sample on request.
+ */
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zmk/activity.h>
+#include <zmk/ble_management/buf_monitor.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define MAX_POOLS CONFIG_ZMK_BLE_MANAGEMENT_BUF_MONITOR_MAX_POOLS
+
+static uint16_t pool_used[MAX_POOLS];
+static uint16_t pool_max_used[MAX_POOLS];
+
+static atomic_t connections;
+static bool active = true;
+
+static void sample_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(sample_work, sample_work_handler);
+
+static bool sampling_wanted(void) {
+    return active && atomic_get(&connections) > 0;
+}
+
+static void update_sampling(void) {
+    if (sampling_wanted()) {
+        k_work_schedule(&sample_work, K_NO_WAIT);
+    } else {
+        k_work_cancel_delayable(&sample_work);
+    }
+}
+
+void zmk_ble_mgmt_buf_monitor_sample(void) {
+    size_t i = 0;
+
+    STRUCT_SECTION_FOREACH(net_buf_pool, pool) {
+        if (i >= MAX_POOLS) {
+            break;
+        }
+
+        uint16_t used = pool->buf_count - atomic_get(&pool->avail_count);
+        pool_used[i]  = used;
+        if (used > pool_max_used[i]) {
+            pool_max_used[i] = used;
+        }
+        i++;
+    }
+}
+
+static void sample_work_handler(struct k_work *work) {
+    zmk_ble_mgmt_buf_monitor_sample();
+
+    if (sampling_wanted()) {
+        k_work_schedule(
+            &sample_work,
+            K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_BUF_MONITOR_INTERVAL_MS));
+    }
+}
+
+static int buf_monitor_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev =
+        as_zmk_activity_state_changed(eh);
+    if (ev) {
+        active = ev->state == ZMK_ACTIVITY_ACTIVE;
+        update_sampling();
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ble_mgmt_buf_monitor, buf_monitor_listener);
+ZMK_SUBSCRIPTION(ble_mgmt_buf_monitor, zmk_activity_state_changed);
+
+static void buf_monitor_connected(struct bt_conn *conn, uint8_t err) {
+    if (!err) {
+        atomic_inc(&connections);
+        update_sampling();
+    }
+}
+
+static void buf_monitor_disconnected(struct bt_conn *conn, uint8_t reason) {
+    atomic_dec(&connections);
+    update_sampling();
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_buf_monitor_conn_cb) = {
+    .connected    = buf_monitor_connected,
+    .disconnected = buf_monitor_disconnected,
+};
+
+size_t zmk_ble_mgmt_buf_monitor_count(void) {
+    int count;
+
+    STRUCT_SECTION_COUNT(net_buf_pool, &count);
+    return MIN(count, MAX_POOLS);
+}
+
+int zmk_ble_mgmt_buf_monitor_get(size_t index,
+                                 struct zmk_ble_mgmt_buf_pool_usage *usage) {
+    if (index >= zmk_ble_mgmt_buf_monitor_count() || !usage) {
+        return -ENOENT;
+    }
+
+    struct net_buf_pool *pool;
+    STRUCT_SECTION_GET(net_buf_pool, index, &pool);
+
+    usage->name     = pool->name;
+    usage->size     = pool->buf_count;
+    usage->used     = pool_used[index];
+    usage->max_used = pool_max_used[index];
+    return 0;
+}
+
+void zmk_ble_mgmt_buf_monitor_reset(void) {
+    for (size_t i = 0; i < MAX_POOLS; i++) {
+        pool_max_used[i] = pool_used[i];
+    }
+}
@@ -0,0 +1,348 @@
+/**
+ * BLE Management Feature - Activity-adaptive connection interval scheduler
+ *
+ * Requests a short connection interval on the active profile while keys are
+ * being pressed, and relaxes to a power-saving interval with peripheral
+ * latency once the keyboard has been idle for a configurable period.
+ * Thresholds are kept per profile and persisted under "ble_mgmt/sched/<idx>".
+ */
+
+#include <stdlib.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/boot_profile.h>
+#include <zmk/ble_management/conn_scheduler.h>
+#include <zmk/ble_management/lazy_settings.h>
+#include <zmk/ble_management/param_update.h>
+#include <zmk/ble_management/profiles.h>
+#include <zmk/ble_management/settings_wear.h>
+#include <zmk/ble_management/supervision.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#include <zmk/events/position_state_changed.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+enum conn_sched_mode {
+    CONN_SCHED_MODE_NONE,
+    CONN_SCHED_MODE_FAST,
+    CONN_SCHED_MODE_SLOW,
+};
+
+// Kconfig defaults are applied statically so settings loaded before
+// application init are never overwritten
+static struct zmk_ble_mgmt_conn_sched_config configs[ZMK_BLE_PROFILE_COUNT] = {
+    [0 ... ZMK_BLE_PROFILE_COUNT - 1] =
+        {
+            .idle_timeout_ms =
+                CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_IDLE_TIMEOUT_MS,
+            .fast_interval =
+                CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_FAST_INTERVAL,
+            .slow_interval =
+                CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_SLOW_INTERVAL,
+            .slow_latency =
+                CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_SLOW_LATENCY,
+        },
+};
+static struct zmk_ble_mgmt_conn_sched_stats stats[ZMK_BLE_PROFILE_COUNT];
+
+// Mode currently requested on the active profile and since when (uptime ms)
+static enum conn_sched_mode current_mode = CONN_SCHED_MODE_NONE;
+static int current_profile               = -1;
+static int64_t mode_since;
+
+static void idle_work_handler(struct k_work *work);
+static void fast_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(idle_work, idle_work_handler);
+static K_WORK_DEFINE(fast_work, fast_work_handler);
+
+/**
+ * Add the time spent in the current mode to the active profile's statistics
+ */
+static void account_mode_time(int64_t now) {
+    if (current_profile >= 0 && current_profile < ZMK_BLE_PROFILE_COUNT) {
+        uint32_t elapsed = (uint32_t)(now - mode_since);
+        switch (current_mode) {
+            case CONN_SCHED_MODE_FAST:
+                stats[current_profile].fast_ms += elapsed;
+                break;
+            case CONN_SCHED_MODE_SLOW:
+                stats[current_profile].slow_ms += elapsed;
+                break;
+            default:
+                break;
+        }
+    }
+    mode_since = now;
+}
+
+/**
+ * Supervision timeout to request, honoring a per-profile override
+ */
+static uint16_t supervision_timeout(uint8_t profile) {
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SUPERVISION)
+    uint16_t timeout = zmk_ble_mgmt_supervision_get_timeout(profile);
+    if (timeout != 0) {
+        return timeout;
+    }
+#endif
+    return CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_TIMEOUT;
+}
+
+/**
+ * Request the connection parameters of the given mode on the active profile
+ */
+static int request_mode(enum conn_sched_mode mode) {
+    int profile = zmk_ble_active_profile_index();
+    if (profile < 0 || profile >= ZMK_BLE_PROFILE_COUNT) {
+        return -EINVAL;
+    }
+
+    struct bt_conn *conn = zmk_ble_mgmt_profile_conn(profile);
+    if (!conn) {
+        return -ENOTCONN;
+    }
+
+    const struct zmk_ble_mgmt_conn_sched_config *cfg = &configs[profile];
+    uint16_t timeout = supervision_timeout(profile);
+    struct bt_le_conn_param param;
+    if (mode == CONN_SCHED_MODE_FAST) {
+        param = (struct bt_le_conn_param)BT_LE_CONN_PARAM_INIT(
+            cfg->fast_interval, cfg->fast_interval, 0, timeout);
+    } else {
+        param = (struct bt_le_conn_param)BT_LE_CONN_PARAM_INIT(
+            cfg->slow_interval, cfg->slow_interval, cfg->slow_latency,
+            timeout);
+    }
+
+    int rc = zmk_ble_mgmt_param_update_request(conn, &param);
+    bt_conn_unref(conn);
+    if (rc < 0 && rc != -EALREADY) {
+        if (rc != -EBUSY) {
+            LOG_WRN("Failed to request %s connection interval: %d",
+                    mode == CONN_SCHED_MODE_FAST ? "fast" : "slow", rc);
+        }
+        return rc;
+    }
+
+    account_mode_time(k_uptime_get());
+    current_profile = profile;
+    current_mode    = mode;
+    if (mode == CONN_SCHED_MODE_FAST) {
+        stats[profile].fast_requests++;
+    } else {
+        stats[profile].slow_requests++;
+    }
+    LOG_DBG("Profile %d switched to %s connection interval", profile,
+            mode == CONN_SCHED_MODE_FAST ? "fast" : "slow");
+    return 0;
+}
+
+static void fast_work_handler(struct k_work *work) {
+    if (current_mode != CONN_SCHED_MODE_FAST) {
+        request_mode(CONN_SCHED_MODE_FAST);
+    }
+}
+
+static void idle_work_handler(struct k_work *work) {
+    // Not current_profile: a disconnect may reset it meanwhile
+    int profile = zmk_ble_active_profile_index();
+    if (profile < 0 || profile >= ZMK_BLE_PROFILE_COUNT) {
+        return;
+    }
+
+    if (current_mode == CONN_SCHED_MODE_FAST &&
+        request_mode(CONN_SCHED_MODE_SLOW) == -EBUSY) {
+        // An earlier request is still outstanding; a failed fast request is
+        // retried by the next key press instead
+        k_work_reschedule(&idle_work,
+                          K_MSEC(configs[profile].idle_timeout_ms));
+    }
+}
+
+static int conn_sched_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *pos =
+        as_zmk_position_state_changed(eh);
+    if (pos) {
+        if (!pos->state) {
+            return ZMK_EV_EVENT_BUBBLE;
+        }
+
+        int profile = zmk_ble_active_profile_index();
+        if (profile < 0 || profile >= ZMK_BLE_PROFILE_COUNT) {
+            return ZMK_EV_EVENT_BUBBLE;
+        }
+
+        if (current_mode != CONN_SCHED_MODE_FAST) {
+            k_work_submit(&fast_work);
+        }
+        k_work_reschedule(&idle_work, K_MSEC(configs[profile].idle_timeout_ms));
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    if (as_zmk_ble_active_profile_changed(eh)) {
+        // Parameters belong to the previous connection; start over
+        k_work_cancel_delayable(&idle_work);
+        account_mode_time(k_uptime_get());
+        current_mode    = CONN_SCHED_MODE_NONE;
+        current_profile = -1;
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ble_mgmt_conn_sched, conn_sched_listener);
+ZMK_SUBSCRIPTION(ble_mgmt_conn_sched, zmk_position_state_changed);
+ZMK_SUBSCRIPTION(ble_mgmt_conn_sched, zmk_ble_active_profile_changed);
+
+static void conn_sched_disconnected(struct bt_conn *conn, uint8_t reason) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile < 0 || profile != current_profile) {
+        return;
+    }
+
+    k_work_cancel_delayable(&idle_work);
+    account_mode_time(k_uptime_get());
+    current_mode    = CONN_SCHED_MODE_NONE;
+    current_profile = -1;
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_conn_sched_conn_cb) = {
+    .disconnected = conn_sched_disconnected,
+};
+
+static bool config_is_valid(const struct zmk_ble_mgmt_conn_sched_config *cfg) {
+    return cfg->idle_timeout_ms > 0 && cfg->fast_interval >= 6 &&
+           cfg->fast_interval <= cfg->slow_interval &&
+           cfg->slow_interval <= 3200 && cfg->slow_latency <= 499;
+}
+
+static bool config_fits_timeout(
+    uint8_t profile, const struct zmk_ble_mgmt_conn_sched_config *cfg) {
+    // Supervision timeout must exceed (1 + latency) * interval * 2
+    uint32_t slow_period = (1 + cfg->slow_latency) * cfg->slow_interval;
+
+    return slow_period < supervision_timeout(profile) * 4;
+}
+
+int zmk_ble_mgmt_conn_sched_get_config(
+    uint8_t profile, struct zmk_ble_mgmt_conn_sched_config *config) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT || !config) {
+        return -EINVAL;
+    }
+
+    *config = configs[profile];
+    return 0;
+}
+
+int zmk_ble_mgmt_conn_sched_set_config(
+    uint8_t profile, const struct zmk_ble_mgmt_conn_sched_config *config) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT || !config) {
+        return -EINVAL;
+    }
+    if (!config_is_valid(config) || !config_fits_timeout(profile, config)) {
+        LOG_WRN("Invalid connection scheduler config for profile %d", profile);
+        return -EINVAL;
+    }
+
+    char setting_name[32];
+    snprintf(setting_name, sizeof(setting_name), "ble_mgmt/sched/%d", profile);
+    int rc = zmk_ble_mgmt_settings_save(setting_name, config, sizeof(*config));
+    if (rc < 0) {
+        return rc;
+    }
+
+    configs[profile] = *config;
+
+    // Re-apply on the next key press so the new thresholds take effect
+    if (profile == current_profile) {
+        account_mode_time(k_uptime_get());
+        current_mode = CONN_SCHED_MODE_NONE;
+    }
+    return 0;
+}
+
+int zmk_ble_mgmt_conn_sched_get_stats(
+    uint8_t profile, struct zmk_ble_mgmt_conn_sched_stats *out) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT || !out) {
+        return -EINVAL;
+    }
+
+    *out = stats[profile];
+    if (profile == current_profile) {
+        // Include the time spent in the ongoing mode
+        uint32_t elapsed = (uint32_t)(k_uptime_get() - mode_since);
+        if (current_mode == CONN_SCHED_MODE_FAST) {
+            out->fast_ms += elapsed;
+        } else if (current_mode == CONN_SCHED_MODE_SLOW) {
+            out->slow_ms += elapsed;
+        }
+    }
+    out->fast_active =
+        (profile == current_profile && current_mode == CONN_SCHED_MODE_FAST);
+    return 0;
+}
+
+/**
+ * Settings callback for loading per-profile thresholds
+ */
+static int conn_sched_settings_set(const char *name, size_t len,
+                                   settings_read_cb read_cb, void *cb_arg) {
+    if (zmk_ble_mgmt_settings_deferred()) {
+        return 0;
+    }
+
+    uint32_t begin = zmk_ble_mgmt_boot_profile_begin();
+    char *end;
+    unsigned long profile = strtoul(name, &end, 10);
+    if (end == name || *end != '\0' || profile >= ZMK_BLE_PROFILE_COUNT) {
+        LOG_WRN("Unknown connection scheduler setting: %s", name);
+        return 0;
+    }
+
+    struct zmk_ble_mgmt_conn_sched_config cfg;
+    if (len != sizeof(cfg)) {
+        LOG_WRN("Invalid connection scheduler setting size: %zu", len);
+        return 0;
+    }
+
+    int rc = read_cb(cb_arg, &cfg, sizeof(cfg));
+    // Checked against the supervision timeout on commit, once that is loaded
+    if (rc >= 0 && config_is_valid(&cfg)) {
+        configs[profile] = cfg;
+    }
+    zmk_ble_mgmt_boot_profile_record_done(begin);
+    return 0;
+}
+
+/**
+ * Settings callback invoked once the ble_mgmt records are loaded, including
+ * the supervision timeouts the slow mode has to fit in
+ */
+static int conn_sched_settings_commit(void) {
+    static const struct zmk_ble_mgmt_conn_sched_config defaults = {
+        .idle_timeout_ms =
+            CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_IDLE_TIMEOUT_MS,
+        .fast_interval = CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_FAST_INTERVAL,
+        .slow_interval = CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_SLOW_INTERVAL,
+        .slow_latency  = CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER_SLOW_LATENCY,
+    };
+
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        if (!config_fits_timeout(i, &configs[i])) {
+            LOG_WRN("Connection scheduler config of profile %d does not fit "
+                    "the supervision timeout, using defaults",
+                    i);
+            configs[i] = defaults;
+        }
+    }
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(ble_mgmt_sched, "ble_mgmt/sched", NULL,
+                               conn_sched_settings_set,
+                               conn_sched_settings_commit, NULL);
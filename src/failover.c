@@ -0,0 +1,147 @@
+/**
+ * BLE Management Feature - Link-loss failover tracking between BLE and USB
+ *
+ * ZMK's endpoint selection already moves reports to the other transport when
+ * the one in use becomes unavailable and returns to the preferred transport
+ * once it recovers. This file records when that happens and how long reports
+ * had nowhere to go.
+ */
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/failover.h>
+#include <zmk/ble_management/profiles.h>
+#include <zmk/endpoints.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/endpoint_changed.h>
+#include <zmk/events/usb_conn_state_changed.h>
+#include <zmk/usb.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+static struct zmk_ble_mgmt_failover_stats failover_stats;
+
+// Unknown until the first endpoint change, which is the initial selection
+static bool transport_known;
+static enum zmk_transport current_transport;
+// Uptime when the transport in use was lost, or 0 when no gap is open
+static int64_t link_lost_at;
+static enum zmk_transport lost_transport;
+
+static void link_lost(enum zmk_transport transport) {
+    if (!transport_known || transport != current_transport ||
+        link_lost_at != 0) {
+        return;
+    }
+
+    link_lost_at   = k_uptime_get();
+    lost_transport = transport;
+    LOG_DBG("Transport %d lost", transport);
+}
+
+static void close_gap(void) {
+    if (link_lost_at == 0) {
+        return;
+    }
+
+    uint32_t gap = (uint32_t)(k_uptime_get() - link_lost_at);
+    link_lost_at = 0;
+
+    failover_stats.gaps++;
+    failover_stats.last_gap_ms = gap;
+    failover_stats.total_gap_ms += gap;
+    if (gap > failover_stats.max_gap_ms) {
+        failover_stats.max_gap_ms = gap;
+    }
+    LOG_DBG("Report gap closed after %u ms", gap);
+}
+
+static bool transport_is_ready(enum zmk_transport transport) {
+    switch (transport) {
+        case ZMK_TRANSPORT_USB:
+            return zmk_usb_is_hid_ready();
+        case ZMK_TRANSPORT_BLE:
+            return zmk_ble_active_profile_is_connected();
+        default:
+            return false;
+    }
+}
+
+static int failover_listener(const zmk_event_t *eh) {
+    const struct zmk_endpoint_changed *ep = as_zmk_endpoint_changed(eh);
+    if (ep) {
+        enum zmk_transport transport = ep->endpoint.transport;
+        if (!transport_known) {
+            transport_known   = true;
+            current_transport = transport;
+            return ZMK_EV_EVENT_BUBBLE;
+        }
+        if (transport != current_transport) {
+            if (!transport_is_ready(current_transport)) {
+                // ZMK may switch before our link-loss hook runs
+                link_lost(current_transport);
+                failover_stats.failovers++;
+                LOG_DBG("Failed over from transport %d to %d",
+                        current_transport, transport);
+            } else if (transport == zmk_endpoints_get_preferred_transport()) {
+                failover_stats.failbacks++;
+                LOG_DBG("Failed back to transport %d", transport);
+            }
+        }
+        current_transport = transport;
+        close_gap();
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_usb_conn_state_changed *usb =
+        as_zmk_usb_conn_state_changed(eh);
+    if (usb) {
+        if (usb->conn_state == ZMK_USB_CONN_HID) {
+            if (lost_transport == ZMK_TRANSPORT_USB) {
+                close_gap();
+            }
+        } else {
+            link_lost(ZMK_TRANSPORT_USB);
+        }
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ble_mgmt_failover, failover_listener);
+ZMK_SUBSCRIPTION(ble_mgmt_failover, zmk_endpoint_changed);
+ZMK_SUBSCRIPTION(ble_mgmt_failover, zmk_usb_conn_state_changed);
+
+static bool is_active_profile_conn(struct bt_conn *conn) {
+    return zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn)) ==
+           zmk_ble_active_profile_index();
+}
+
+static void failover_connected(struct bt_conn *conn, uint8_t err) {
+    if (!err && lost_transport == ZMK_TRANSPORT_BLE &&
+        is_active_profile_conn(conn)) {
+        close_gap();
+    }
+}
+
+static void failover_disconnected(struct bt_conn *conn, uint8_t reason) {
+    if (is_active_profile_conn(conn)) {
+        link_lost(ZMK_TRANSPORT_BLE);
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_failover_conn_cb) = {
+    .connected    = failover_connected,
+    .disconnected = failover_disconnected,
+};
+
+int zmk_ble_mgmt_failover_get_stats(struct zmk_ble_mgmt_failover_stats *stats) {
+    if (!stats) {
+        return -EINVAL;
+    }
+
+    *stats = failover_stats;
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * BLE Management Feature - Deferred loading of ble_mgmt settings
+ *
+ * ble_mgmt records are skipped during the global settings load at boot so
+ * they do not compete with keymap and bond loading. The subtree is loaded
+ * with settings_load_subtree("ble_mgmt") on the first Studio RPC, or from
+ * ZMK's low priority work queue once a host has been connected for a while
+ * (or after the same delay from boot when no host connects). Callers that
+ * arrive while the work item is loading wait for it to finish, and a failed
+ * load is retried after the same delay.
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+#include <zmk/ble_management/lazy_settings.h>
+#include <zmk/workqueue.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zephyr/bluetooth/conn.h>
+#endif
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define LOAD_DELAY K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_LAZY_SETTINGS_DELAY_MS)
+
+enum load_state {
+    LOAD_STATE_DEFERRED,
+    // Records are accepted; load_lock is held until the load is over
+    LOAD_STATE_LOADING,
+    LOAD_STATE_LOADED,
+};
+
+static atomic_t state = ATOMIC_INIT(LOAD_STATE_DEFERRED);
+
+// Callers of ensure_loaded wait here until a load in progress has finished
+static K_MUTEX_DEFINE(load_lock);
+
+static void load_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(load_work, load_work_handler);
+
+bool zmk_ble_mgmt_settings_deferred(void) {
+    return atomic_get(&state) == LOAD_STATE_DEFERRED;
+}
+
+void zmk_ble_mgmt_settings_ensure_loaded(void) {
+    if (atomic_get(&state) == LOAD_STATE_LOADED) {
+        return;
+    }
+
+    k_mutex_lock(&load_lock, K_FOREVER);
+    if (atomic_get(&state) == LOAD_STATE_LOADED) {
+        k_mutex_unlock(&load_lock);
+        return;
+    }
+
+    k_work_cancel_delayable(&load_work);
+
+    // Let the handlers accept the records
+    atomic_set(&state, LOAD_STATE_LOADING);
+    int64_t start = k_uptime_get();
+    int rc        = settings_load_subtree("ble_mgmt");
+    if (rc < 0) {
+        LOG_WRN("Failed to load ble_mgmt settings: %d", rc);
+        atomic_set(&state, LOAD_STATE_DEFERRED);
+        k_work_reschedule_for_queue(zmk_workqueue_lowprio_work_q(), &load_work,
+                                    LOAD_DELAY);
+    } else {
+        atomic_set(&state, LOAD_STATE_LOADED);
+        LOG_DBG("Loaded ble_mgmt settings in %lld ms",
+                k_uptime_get() - start);
+    }
+    k_mutex_unlock(&load_lock);
+}
+
+static void load_work_handler(struct k_work *work) {
+    zmk_ble_mgmt_settings_ensure_loaded();
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+static void lazy_settings_connected(struct bt_conn *conn, uint8_t err) {
+    if (!err && atomic_get(&state) != LOAD_STATE_LOADED) {
+        k_work_reschedule_for_queue(zmk_workqueue_lowprio_work_q(), &load_work,
+                                    LOAD_DELAY);
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_lazy_settings_conn_cb) = {
+    .connected = lazy_settings_connected,
+};
+#endif
+
+static int lazy_settings_init(void) {
+    // Fallback for keyboards that are never connected over BLE
+    k_work_schedule_for_queue(zmk_workqueue_lowprio_work_q(), &load_work,
+                              LOAD_DELAY);
+    return 0;
+}
+
+SYS_INIT(lazy_settings_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,148 @@
+/**
+ * BLE Management Feature - Link-time hooks into ZMK and Zephyr
+ *
+ * ZMK and Zephyr have no callbacks for report delivery, advertising/scanning
+ * start or settings loading, so these entry points are wrapped at link time
+ * (-Wl,--wrap, see CMakeLists.txt) and dispatched to the features using them.
+ * Each wrap is only linked in when a feature selects its hook.
+ */
+
+#include <zephyr/kernel.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_SEND_REPORT)
+#include <zmk/endpoints.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_GATT_NOTIFY)
+#include <zephyr/bluetooth/gatt.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_ADV_START) ||                   \
+    IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_SCAN_START)
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zmk/ble_management/boot_profile.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_SETTINGS_LOAD)
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/ble_management/boot_profile.h>
+#include <zmk/ble_management/lazy_settings.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_REPORT_STATS)
+#include <zmk/ble_management/report_stats.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_WAKE_LATENCY)
+#include <zmk/ble_management/wake_latency.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+#include <zmk/ble_management/split_reconnect.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING)
+#include <zmk/ble_management/provisioning.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_SEND_REPORT)
+int __real_zmk_endpoints_send_report(uint16_t usage_page);
+
+int __wrap_zmk_endpoints_send_report(uint16_t usage_page) {
+    struct zmk_endpoint_instance endpoint = zmk_endpoints_selected();
+    int rc = __real_zmk_endpoints_send_report(usage_page);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_REPORT_STATS)
+    zmk_ble_mgmt_report_stats_on_send(&endpoint, rc);
+#endif
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_WAKE_LATENCY)
+    if (rc == 0 && endpoint.transport == ZMK_TRANSPORT_BLE) {
+        zmk_ble_mgmt_wake_latency_report_sent(endpoint.ble.profile_index);
+    }
+#endif
+    return rc;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_GATT_NOTIFY)
+int __real_bt_gatt_notify_cb(struct bt_conn *conn,
+                             struct bt_gatt_notify_params *params);
+
+int __wrap_bt_gatt_notify_cb(struct bt_conn *conn,
+                             struct bt_gatt_notify_params *params) {
+    int rc = __real_bt_gatt_notify_cb(conn, params);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_REPORT_STATS)
+    zmk_ble_mgmt_report_stats_on_notify(conn, params, rc);
+#endif
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING)
+    zmk_ble_mgmt_provisioning_on_notify(conn, rc);
+#endif
+    return rc;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_ADV_START)
+int __real_bt_le_adv_start(const struct bt_le_adv_param *param,
+                           const struct bt_data *ad, size_t ad_len,
+                           const struct bt_data *sd, size_t sd_len);
+
+int __wrap_bt_le_adv_start(const struct bt_le_adv_param *param,
+                           const struct bt_data *ad, size_t ad_len,
+                           const struct bt_data *sd, size_t sd_len) {
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+    struct bt_le_adv_param fast_param;
+    param = zmk_ble_mgmt_split_reconnect_adv_param(param, &fast_param);
+#endif
+
+    int rc = __real_bt_le_adv_start(param, ad, ad_len, sd, sd_len);
+    if (rc != 0) {
+        return rc;
+    }
+
+    zmk_ble_mgmt_boot_profile_mark(ZMK_BLE_MGMT_BOOT_FIRST_ADV);
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_WAKE_LATENCY)
+    zmk_ble_mgmt_wake_latency_adv_started();
+#endif
+    return rc;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_SCAN_START)
+int __real_bt_le_scan_start(const struct bt_le_scan_param *param,
+                            bt_le_scan_cb_t cb);
+
+int __wrap_bt_le_scan_start(const struct bt_le_scan_param *param,
+                            bt_le_scan_cb_t cb) {
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+    struct bt_le_scan_param fast_param;
+    param = zmk_ble_mgmt_split_reconnect_scan_param(param, &fast_param);
+#endif
+    return __real_bt_le_scan_start(param, cb);
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_HOOK_SETTINGS_LOAD)
+int __real_settings_load(void);
+int __real_settings_load_subtree(const char *subtree);
+
+// Only the load that hands ble_mgmt records to the handlers counts, which is
+// the deferred subtree load when lazy settings are enabled
+static void settings_load_starting(const char *subtree) {
+    if ((!subtree || !strcmp(subtree, "ble_mgmt")) &&
+        !zmk_ble_mgmt_settings_deferred()) {
+        zmk_ble_mgmt_boot_profile_mark(ZMK_BLE_MGMT_BOOT_SETTINGS_LOAD_START);
+    }
+}
+
+int __wrap_settings_load(void) {
+    settings_load_starting(NULL);
+    return __real_settings_load();
+}
+
+int __wrap_settings_load_subtree(const char *subtree) {
+    settings_load_starting(subtree);
+    return __real_settings_load_subtree(subtree);
+}
+#endif
@@ -0,0 +1,130 @@
+/**
+ * BLE Management Feature - Metrics registry
+ *
+ * The registry is the iterable section the definition macros place metrics
+ * in (see include/linker/zmk-ble-management-metrics.ld); this file only
+ * reads it. Values are atomics, so metrics can be updated from any context
+ * without a lock and a dump is consistent per value, not across values.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zmk/ble_management/metrics.h>
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME  16777619u
+
+void zmk_ble_mgmt_metric_observe(const struct zmk_ble_mgmt_metric *metric,
+                                 uint32_t value) {
+    for (uint8_t i = 0; i < metric->buckets; i++) {
+        if (value < metric->bounds[i] || i == metric->buckets - 1) {
+            atomic_inc(&metric->values[i]);
+            return;
+        }
+    }
+}
+
+size_t zmk_ble_mgmt_metrics_count(void) {
+    int count;
+    STRUCT_SECTION_COUNT(zmk_ble_mgmt_metric, &count);
+    return count;
+}
+
+const struct zmk_ble_mgmt_metric *zmk_ble_mgmt_metrics_get(size_t index) {
+    if (index >= zmk_ble_mgmt_metrics_count()) {
+        return NULL;
+    }
+
+    const struct zmk_ble_mgmt_metric *metric;
+    STRUCT_SECTION_GET(zmk_ble_mgmt_metric, index, &metric);
+    return metric;
+}
+
+static uint32_t fnv1a(uint32_t hash, const void *data, size_t len) {
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t zmk_ble_mgmt_metrics_schema_id(void) {
+    // The schema is fixed at build time
+    static uint32_t schema_id;
+    if (schema_id) {
+        return schema_id;
+    }
+
+    uint32_t hash = FNV_OFFSET;
+    STRUCT_SECTION_FOREACH(zmk_ble_mgmt_metric, metric) {
+        uint8_t type = metric->type;
+        hash         = fnv1a(hash, metric->name, strlen(metric->name) + 1);
+        hash         = fnv1a(hash, &type, sizeof(type));
+        hash         = fnv1a(hash, metric->bounds,
+                             metric->buckets * sizeof(metric->bounds[0]));
+    }
+    schema_id = hash;
+    return schema_id;
+}
+
+static size_t varint_size(uint32_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static uint8_t *varint_put(uint8_t *buf, uint32_t value) {
+    while (value >= 0x80) {
+        *buf++ = (value & 0x7f) | 0x80;
+        value >>= 7;
+    }
+    *buf++ = value;
+    return buf;
+}
+
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+size_t zmk_ble_mgmt_metrics_dump(size_t first, uint8_t *buf, size_t size,
+                                 size_t *len) {
+    size_t count = zmk_ble_mgmt_metrics_count();
+    size_t used  = 0;
+    size_t index = first;
+
+    __ASSERT(size >= ZMK_BLE_MGMT_METRIC_MAX_SIZE,
+             "Metrics dump buffer of %zu bytes may not fit a metric", size);
+
+    for (; index < count; index++) {
+        const struct zmk_ble_mgmt_metric *metric =
+            zmk_ble_mgmt_metrics_get(index);
+        size_t values = MAX(metric->buckets, 1);
+
+        // Snapshot first so the size check and the encoding agree
+        uint32_t snapshot[ZMK_BLE_MGMT_METRIC_MAX_BUCKETS];
+        size_t needed = 0;
+        for (size_t i = 0; i < values; i++) {
+            snapshot[i] = atomic_get(&metric->values[i]);
+            if (metric->type == ZMK_BLE_MGMT_METRIC_GAUGE) {
+                snapshot[i] = zigzag(snapshot[i]);
+            }
+            needed += varint_size(snapshot[i]);
+        }
+        if (used + needed > size) {
+            break;
+        }
+
+        uint8_t *out = buf + used;
+        for (size_t i = 0; i < values; i++) {
+            out = varint_put(out, snapshot[i]);
+        }
+        used += needed;
+    }
+
+    *len = used;
+    return index;
+}
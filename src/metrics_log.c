@@ -0,0 +1,164 @@
+/**
+ * BLE Management Feature - Periodic metrics log lines
+ *
+ * For keyboards without Studio: every interval the profile state and the
+ * metrics registry are written through the logging backend (USB CDC, RTT,
+ * UART) as compact lines that scripts/metrics_log.py turns back into named
+ * values. The lines of one emission share a sequence number:
+ *   BLEM <seq> P <uptime_ms> <active> <states>
+ *   BLEM <seq> S <schema_id> <first> <name>:<c|g|h>[:<bound>,...] ...
+ *   BLEM <seq> V <schema_id> <first> <values>
+ * States has one character per profile: o open, b bonded, c connected.
+ * Schema lines describe as many metrics as fit, starting at metric <first>,
+ * and are only part of the first and every Nth emission. Values are the
+ * GetMetrics dump in hex, starting at metric <first>.
+ *
+ * One line is logged per work run, with a short gap in between, so that an
+ * emission does not overflow the buffer of deferred logging.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/metrics.h>
+
+#include <zephyr/logging/log.h>
+// Own module so the lines are emitted whatever the ZMK log level is
+LOG_MODULE_REGISTER(ble_mgmt_metrics, LOG_LEVEL_INF);
+
+// Dump bytes per V line, enough for any one metric
+#define VALUES_PER_LINE ZMK_BLE_MGMT_METRIC_MAX_SIZE
+
+// Schema entries per S line: enough for one metric with the longest name
+// and every bucket bound, plus the separating space
+#define SCHEMA_PER_LINE                                                        \
+    (ZMK_BLE_MGMT_METRIC_NAME_MAX + 4 + ZMK_BLE_MGMT_METRIC_MAX_BUCKETS * 11)
+
+#define LINE_GAP K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_METRICS_LOG_LINE_GAP_MS)
+#define INTERVAL K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_METRICS_LOG_INTERVAL_MS)
+#define SCHEMA_EVERY CONFIG_ZMK_BLE_MANAGEMENT_METRICS_LOG_SCHEMA_EVERY
+
+enum emit_phase {
+    EMIT_PROFILES,
+    EMIT_SCHEMA,
+    EMIT_VALUES,
+};
+
+static uint32_t seq;
+static enum emit_phase phase;
+// Next metric of the schema or values phase
+static size_t next_metric;
+// Id of the schema the emission started with
+static uint32_t schema_id;
+
+static void emit_profiles(void) {
+    char states[ZMK_BLE_PROFILE_COUNT + 1];
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        states[i] = zmk_ble_profile_is_open(i)        ? 'o'
+                    : zmk_ble_profile_is_connected(i) ? 'c'
+                                                      : 'b';
+    }
+    states[ZMK_BLE_PROFILE_COUNT] = '\0';
+
+    LOG_INF("BLEM %u P %u %d %s", seq, k_uptime_get_32(),
+            zmk_ble_active_profile_index(), states);
+}
+
+// Append " <name>:<type>[:<bound>,...]", returning its length
+static size_t format_metric(char *buf, size_t size,
+                            const struct zmk_ble_mgmt_metric *metric) {
+    static const char types[] = {
+        [ZMK_BLE_MGMT_METRIC_COUNTER]   = 'c',
+        [ZMK_BLE_MGMT_METRIC_GAUGE]     = 'g',
+        [ZMK_BLE_MGMT_METRIC_HISTOGRAM] = 'h',
+    };
+
+    size_t len = snprintf(buf, size, " %s:%c", metric->name,
+                          types[metric->type]);
+    for (uint8_t b = 0; b < metric->buckets && len < size; b++) {
+        len += snprintf(buf + len, size - len, "%c%u", b ? ',' : ':',
+                        metric->bounds[b]);
+    }
+    return len;
+}
+
+static size_t emit_schema(size_t first) {
+    size_t count = zmk_ble_mgmt_metrics_count();
+    char line[SCHEMA_PER_LINE + 1];
+    size_t len  = 0;
+    size_t next = first;
+
+    while (next < count) {
+        size_t entry_len = format_metric(line + len, sizeof(line) - len,
+                                         zmk_ble_mgmt_metrics_get(next));
+        if (len + entry_len >= sizeof(line)) {
+            // Truncated; left for the next line
+            break;
+        }
+        len += entry_len;
+        next++;
+    }
+    line[len] = '\0';
+
+    LOG_INF("BLEM %u S %08x %zu%s", seq, schema_id, first, line);
+    return next;
+}
+
+static size_t emit_values(size_t first) {
+    uint8_t values[VALUES_PER_LINE];
+    char hex[VALUES_PER_LINE * 2 + 1];
+    size_t len;
+
+    size_t next =
+        zmk_ble_mgmt_metrics_dump(first, values, sizeof(values), &len);
+    bin2hex(values, len, hex, sizeof(hex));
+    LOG_INF("BLEM %u V %08x %zu %s", seq, schema_id, first, hex);
+    return next;
+}
+
+static void metrics_log_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(metrics_log_work, metrics_log_work_handler);
+
+static void metrics_log_work_handler(struct k_work *work) {
+    size_t count = zmk_ble_mgmt_metrics_count();
+
+    switch (phase) {
+        case EMIT_PROFILES:
+            schema_id = zmk_ble_mgmt_metrics_schema_id();
+            emit_profiles();
+            next_metric = 0;
+            phase       = count > 0 && seq % SCHEMA_EVERY == 0 ? EMIT_SCHEMA
+                                                               : EMIT_VALUES;
+            break;
+        case EMIT_SCHEMA:
+            next_metric = emit_schema(next_metric);
+            if (next_metric >= count) {
+                next_metric = 0;
+                phase       = EMIT_VALUES;
+            }
+            break;
+        case EMIT_VALUES:
+            next_metric = emit_values(next_metric);
+            break;
+    }
+
+    if (phase == EMIT_VALUES && next_metric >= count) {
+        // Emission complete
+        phase = EMIT_PROFILES;
+        seq++;
+        k_work_schedule(&metrics_log_work, INTERVAL);
+        return;
+    }
+
+    k_work_schedule(&metrics_log_work, LINE_GAP);
+}
+
+static int metrics_log_init(void) {
+    k_work_schedule(&metrics_log_work, INTERVAL);
+    return 0;
+}
+
+SYS_INIT(metrics_log_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
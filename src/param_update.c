@@ -0,0 +1,209 @@
+/**
+ * BLE Management Feature - Connection parameter update tracking
+ *
+ * Hosts often reject or silently ignore parameter update requests. Requests
+ * made by this module are followed until the host reports new parameters:
+ * matching parameters count as accepted, different ones as rejected, and no
+ * update within the response timeout triggers a retry with exponential
+ * backoff, counting as ignored once the retry limit is reached. Only one
+ * request per profile is followed at a time; callers are refused until it
+ * is answered or given up, rather than replacing its parameters. Totals
+ * over every profile are also kept in the metrics registry.
+ */
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/metrics.h>
+#include <zmk/ble_management/param_update.h>
+#include <zmk/ble_management/profiles.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_param_attempts,
+                                   "param_attempts");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_param_retries,
+                                   "param_retries");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_param_accepted,
+                                   "param_accepted");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_param_rejected,
+                                   "param_rejected");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_param_ignored,
+                                   "param_ignored");
+
+struct param_update_state {
+    struct k_work_delayable work;
+    struct bt_le_conn_param param;
+    uint8_t retries;
+    bool active;
+    // Waiting for the host's answer, as opposed to waiting out a backoff
+    bool awaiting;
+};
+
+static struct param_update_state states[ZMK_BLE_PROFILE_COUNT];
+static struct zmk_ble_mgmt_param_update_stats stats[ZMK_BLE_PROFILE_COUNT];
+
+static void send_request(uint8_t profile) {
+    struct param_update_state *st = &states[profile];
+    struct bt_conn *conn          = zmk_ble_mgmt_profile_conn(profile);
+    if (!conn) {
+        st->active = false;
+        return;
+    }
+
+    int rc = bt_conn_le_param_update(conn, &st->param);
+    bt_conn_unref(conn);
+    if (rc < 0) {
+        LOG_DBG("Parameter update request on profile %d failed: %d", profile,
+                rc);
+    }
+
+    // A failed request is retried like an unanswered one
+    st->awaiting = true;
+    k_work_reschedule(
+        &st->work,
+        K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_PARAM_UPDATE_RESPONSE_TIMEOUT_MS));
+}
+
+static void param_update_work_handler(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct param_update_state *st =
+        CONTAINER_OF(dwork, struct param_update_state, work);
+    uint8_t profile = st - states;
+
+    if (!st->active) {
+        return;
+    }
+
+    if (!st->awaiting) {
+        send_request(profile);
+        return;
+    }
+
+    if (st->retries >= CONFIG_ZMK_BLE_MANAGEMENT_PARAM_UPDATE_MAX_RETRIES) {
+        LOG_WRN("Profile %d ignored parameter update after %d retries",
+                profile, st->retries);
+        stats[profile].ignored++;
+        ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_param_ignored);
+        st->active = false;
+        return;
+    }
+
+    uint32_t backoff = CONFIG_ZMK_BLE_MANAGEMENT_PARAM_UPDATE_BACKOFF_MS
+                       << st->retries;
+    st->retries++;
+    st->awaiting = false;
+    stats[profile].retries++;
+    ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_param_retries);
+    k_work_reschedule(&st->work, K_MSEC(backoff));
+}
+
+int zmk_ble_mgmt_param_update_request(struct bt_conn *conn,
+                                      const struct bt_le_conn_param *param) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile < 0) {
+        return bt_conn_le_param_update(conn, param);
+    }
+
+    struct bt_conn_info info;
+    if (bt_conn_get_info(conn, &info) == 0 &&
+        info.le.interval >= param->interval_min &&
+        info.le.interval <= param->interval_max &&
+        info.le.latency == param->latency &&
+        info.le.timeout == param->timeout) {
+        // Already in effect; the host will not report an update
+        return -EALREADY;
+    }
+
+    struct param_update_state *st = &states[profile];
+    if (st->active) {
+        return -EBUSY;
+    }
+
+    // Armed before sending so an answer that arrives right away is matched
+    st->param    = *param;
+    st->retries  = 0;
+    st->active   = true;
+    st->awaiting = true;
+
+    int rc = bt_conn_le_param_update(conn, param);
+    if (rc < 0) {
+        // Nothing was sent (-EALREADY: already in effect), so there is no
+        // answer to wait for
+        st->active = false;
+        return rc;
+    }
+
+    stats[profile].attempts++;
+    ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_param_attempts);
+    k_work_reschedule(
+        &st->work,
+        K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_PARAM_UPDATE_RESPONSE_TIMEOUT_MS));
+    return 0;
+}
+
+int zmk_ble_mgmt_param_update_get_stats(
+    uint8_t profile, struct zmk_ble_mgmt_param_update_stats *out) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT || !out) {
+        return -EINVAL;
+    }
+
+    *out = stats[profile];
+    return 0;
+}
+
+static void param_update_le_param_updated(struct bt_conn *conn,
+                                          uint16_t interval, uint16_t latency,
+                                          uint16_t timeout) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile < 0) {
+        return;
+    }
+
+    stats[profile].last_interval = interval;
+    stats[profile].last_latency  = latency;
+    stats[profile].last_timeout  = timeout;
+
+    struct param_update_state *st = &states[profile];
+    if (!st->active) {
+        return;
+    }
+
+    st->active = false;
+    k_work_cancel_delayable(&st->work);
+    if (interval >= st->param.interval_min &&
+        interval <= st->param.interval_max && latency == st->param.latency &&
+        timeout == st->param.timeout) {
+        stats[profile].accepted++;
+        ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_param_accepted);
+    } else {
+        LOG_DBG("Profile %d applied %d/%d/%d instead of requested parameters",
+                profile, interval, latency, timeout);
+        stats[profile].rejected++;
+        ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_param_rejected);
+    }
+}
+
+static void param_update_disconnected(struct bt_conn *conn, uint8_t reason) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile >= 0 && states[profile].active) {
+        states[profile].active = false;
+        k_work_cancel_delayable(&states[profile].work);
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_param_update_conn_cb) = {
+    .disconnected     = param_update_disconnected,
+    .le_param_updated = param_update_le_param_updated,
+};
+
+static int param_update_init(void) {
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        k_work_init_delayable(&states[i].work, param_update_work_handler);
+    }
+    return 0;
+}
+
+SYS_INIT(param_update_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,337 @@
+/**
+ * BLE Management Feature - Factory provisioning cycles
+ *
+ * Runs pair, verify and unpair cycles against a test host unattended, for
+ * assembly line checks. Each cycle:
+ * - connect: the profile is selected and opened; ends when a host that is
+ *   not bonded to another profile connects
+ * - pair: ends when that host has bonded with the profile
+ * - verify: the current (normally empty) keyboard report is sent every few
+ *   ms until one notification is accepted, which requires the host to have
+ *   subscribed to the HID input report
+ * - unpair: the bond is removed; ends when the host is disconnected
+ * A step that does not finish in time, or a disconnect before the unpair
+ * step, fails the cycle and the next one starts. Durations of every
+ * completed step are kept for the run. The run should be driven over USB,
+ * as a Studio connection over BLE would be dropped by the cycles.
+ */
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/profiles.h>
+#include <zmk/ble_management/provisioning.h>
+#include <zmk/hid.h>
+#include <zmk/hog.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define STEP_TIMEOUT                                                           \
+    K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING_STEP_TIMEOUT_MS)
+#define VERIFY_RETRY                                                           \
+    K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING_VERIFY_RETRY_MS)
+
+static struct zmk_ble_mgmt_provisioning_status status = {
+    .step             = ZMK_BLE_MGMT_PROVISIONING_NONE,
+    .last_failed_step = ZMK_BLE_MGMT_PROVISIONING_NONE,
+};
+
+static int64_t run_started_at;
+static int64_t cycle_started_at;
+static int64_t step_started_at;
+
+// Host connection of the cycle in progress
+static struct bt_conn *cycle_conn;
+// Connection of an aborted cycle, dropped by the cycle work
+static struct bt_conn *stale_conn;
+
+static K_MUTEX_DEFINE(provisioning_mutex);
+
+static void cycle_work_handler(struct k_work *work);
+static void unpair_work_handler(struct k_work *work);
+static void verify_work_handler(struct k_work *work);
+static void timeout_work_handler(struct k_work *work);
+
+static K_WORK_DEFINE(cycle_work, cycle_work_handler);
+static K_WORK_DEFINE(unpair_work, unpair_work_handler);
+static K_WORK_DELAYABLE_DEFINE(verify_work, verify_work_handler);
+static K_WORK_DELAYABLE_DEFINE(timeout_work, timeout_work_handler);
+
+static void begin_step(enum zmk_ble_mgmt_provisioning_step step) {
+    status.step     = step;
+    step_started_at = k_uptime_get();
+    k_work_reschedule(&timeout_work, STEP_TIMEOUT);
+}
+
+/**
+ * Record the duration of the step in progress and start the next one
+ */
+static void finish_step(void) {
+    struct zmk_ble_mgmt_provisioning_step_stats *stats =
+        &status.steps[status.step];
+    uint32_t elapsed = k_uptime_get() - step_started_at;
+
+    stats->last_ms = elapsed;
+    stats->min_ms  = stats->count ? MIN(stats->min_ms, elapsed) : elapsed;
+    stats->max_ms  = MAX(stats->max_ms, elapsed);
+    stats->total_ms += elapsed;
+    stats->count++;
+
+    if (status.step + 1 < ZMK_BLE_MGMT_PROVISIONING_STEP_COUNT) {
+        begin_step(status.step + 1);
+        return;
+    }
+
+    k_work_cancel_delayable(&timeout_work);
+    status.cycles_passed++;
+    status.last_cycle_ms = k_uptime_get() - cycle_started_at;
+    status.step          = ZMK_BLE_MGMT_PROVISIONING_NONE;
+    LOG_DBG("Provisioning cycle passed in %u ms", status.last_cycle_ms);
+    k_work_submit(&cycle_work);
+}
+
+static void fail_cycle(void) {
+    LOG_WRN("Provisioning cycle failed in step %d", status.step);
+    status.cycles_failed++;
+    status.last_failed_step = status.step;
+    status.step             = ZMK_BLE_MGMT_PROVISIONING_NONE;
+
+    k_work_cancel_delayable(&timeout_work);
+    k_work_cancel_delayable(&verify_work);
+    if (cycle_conn) {
+        stale_conn = cycle_conn;
+        cycle_conn = NULL;
+    }
+    k_work_submit(&cycle_work);
+}
+
+/**
+ * Make the profile active and open
+ */
+static void open_profile(void) {
+    if (zmk_ble_active_profile_index() != status.profile) {
+        zmk_ble_prof_select(status.profile);
+    }
+    if (!zmk_ble_profile_is_open(status.profile)) {
+        zmk_ble_clear_bonds();
+    }
+}
+
+/**
+ * Clean up after the previous cycle and start the next one, or end the run
+ */
+static void cycle_work_handler(struct k_work *work) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+
+    if (stale_conn) {
+        bt_conn_disconnect(stale_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+        bt_conn_unref(stale_conn);
+        stale_conn = NULL;
+    }
+    open_profile();
+
+    uint32_t cycles = status.cycles_passed + status.cycles_failed;
+    if (status.running && cycles < status.cycles_requested) {
+        cycle_started_at = k_uptime_get();
+        begin_step(ZMK_BLE_MGMT_PROVISIONING_CONNECT);
+    } else if (status.running) {
+        status.running    = false;
+        status.elapsed_ms = k_uptime_get() - run_started_at;
+        LOG_INF("Provisioning done: %u passed, %u failed in %u ms",
+                status.cycles_passed, status.cycles_failed,
+                status.elapsed_ms);
+    }
+
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+static void unpair_work_handler(struct k_work *work) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    // Removing the bond disconnects the host, which ends the step
+    if (status.step == ZMK_BLE_MGMT_PROVISIONING_UNPAIR) {
+        open_profile();
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+static void verify_work_handler(struct k_work *work) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    bool verifying = status.step == ZMK_BLE_MGMT_PROVISIONING_VERIFY;
+    k_mutex_unlock(&provisioning_mutex);
+
+    // Notifications fail until the host has subscribed; keep trying. The
+    // report may block on a full queue, so it is sent without the lock.
+    if (verifying) {
+        zmk_hog_send_keyboard_report(&zmk_hid_get_keyboard_report()->body);
+        k_work_reschedule(&verify_work, VERIFY_RETRY);
+    }
+}
+
+static void timeout_work_handler(struct k_work *work) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (status.step != ZMK_BLE_MGMT_PROVISIONING_NONE) {
+        fail_cycle();
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+void zmk_ble_mgmt_provisioning_on_notify(struct bt_conn *conn, int rc) {
+    if (rc != 0) {
+        return;
+    }
+
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (status.step == ZMK_BLE_MGMT_PROVISIONING_VERIFY && conn &&
+        conn == cycle_conn) {
+        k_work_cancel_delayable(&verify_work);
+        finish_step();
+        k_work_submit(&unpair_work);
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+static void provisioning_connected(struct bt_conn *conn, uint8_t err) {
+    struct bt_conn_info info;
+    if (err || bt_conn_get_info(conn, &info) != 0 ||
+        info.role != BT_CONN_ROLE_PERIPHERAL ||
+        zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn)) >= 0) {
+        return;
+    }
+
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (status.step == ZMK_BLE_MGMT_PROVISIONING_CONNECT && !cycle_conn) {
+        cycle_conn = bt_conn_ref(conn);
+        finish_step();
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+static void provisioning_disconnected(struct bt_conn *conn, uint8_t reason) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (conn == cycle_conn) {
+        bt_conn_unref(cycle_conn);
+        cycle_conn = NULL;
+        if (status.step == ZMK_BLE_MGMT_PROVISIONING_UNPAIR) {
+            finish_step();
+        } else if (status.step != ZMK_BLE_MGMT_PROVISIONING_NONE) {
+            fail_cycle();
+        }
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+static void provisioning_security_changed(struct bt_conn *conn,
+                                          bt_security_t level,
+                                          enum bt_security_err err) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (err && conn == cycle_conn &&
+        status.step == ZMK_BLE_MGMT_PROVISIONING_PAIR) {
+        fail_cycle();
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_provisioning_conn_cb) = {
+    .connected        = provisioning_connected,
+    .disconnected     = provisioning_disconnected,
+    .security_changed = provisioning_security_changed,
+};
+
+static void provisioning_pairing_complete(struct bt_conn *conn, bool bonded) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (conn == cycle_conn && status.step == ZMK_BLE_MGMT_PROVISIONING_PAIR) {
+        if (bonded) {
+            finish_step();
+            k_work_reschedule(&verify_work, K_NO_WAIT);
+        } else {
+            fail_cycle();
+        }
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+static void provisioning_pairing_failed(struct bt_conn *conn,
+                                        enum bt_security_err reason) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (conn == cycle_conn && status.step == ZMK_BLE_MGMT_PROVISIONING_PAIR) {
+        fail_cycle();
+    }
+    k_mutex_unlock(&provisioning_mutex);
+}
+
+static struct bt_conn_auth_info_cb provisioning_auth_info_cb = {
+    .pairing_complete = provisioning_pairing_complete,
+    .pairing_failed   = provisioning_pairing_failed,
+};
+
+int zmk_ble_mgmt_provisioning_start(uint8_t profile, uint32_t cycles) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT || cycles == 0) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (status.running) {
+        k_mutex_unlock(&provisioning_mutex);
+        return -EBUSY;
+    }
+
+    status = (struct zmk_ble_mgmt_provisioning_status){
+        .running          = true,
+        .profile          = profile,
+        .step             = ZMK_BLE_MGMT_PROVISIONING_NONE,
+        .cycles_requested = cycles,
+        .last_failed_step = ZMK_BLE_MGMT_PROVISIONING_NONE,
+    };
+    run_started_at = k_uptime_get();
+    k_work_submit(&cycle_work);
+
+    k_mutex_unlock(&provisioning_mutex);
+    LOG_INF("Provisioning %u cycles on profile %d", cycles, profile);
+    return 0;
+}
+
+int zmk_ble_mgmt_provisioning_stop(void) {
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    if (!status.running) {
+        k_mutex_unlock(&provisioning_mutex);
+        return -EALREADY;
+    }
+
+    status.running    = false;
+    status.step       = ZMK_BLE_MGMT_PROVISIONING_NONE;
+    status.elapsed_ms = k_uptime_get() - run_started_at;
+    k_work_cancel_delayable(&timeout_work);
+    k_work_cancel_delayable(&verify_work);
+    if (cycle_conn) {
+        stale_conn = cycle_conn;
+        cycle_conn = NULL;
+    }
+    k_work_submit(&cycle_work);
+
+    k_mutex_unlock(&provisioning_mutex);
+    return 0;
+}
+
+int zmk_ble_mgmt_provisioning_get_status(
+    struct zmk_ble_mgmt_provisioning_status *out) {
+    if (!out) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&provisioning_mutex, K_FOREVER);
+    *out = status;
+    if (status.running) {
+        out->elapsed_ms = k_uptime_get() - run_started_at;
+    }
+    k_mutex_unlock(&provisioning_mutex);
+    return 0;
+}
+
+static int provisioning_init(void) {
+    return bt_conn_auth_info_cb_register(&provisioning_auth_info_cb);
+}
+
+SYS_INIT(provisioning_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
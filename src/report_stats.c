@@ -0,0 +1,122 @@
+/**
+ * BLE Management Feature - HID report delivery statistics
+ *
+ * Counts the results of report sends and HID GATT notifications reported by
+ * the link-time hooks (see link_hooks.c), broken down by USB vs BLE and by
+ * BLE profile. Totals over every endpoint are also kept in the metrics
+ * registry.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zmk/ble_management/metrics.h>
+#include <zmk/ble_management/report_stats.h>
+#include <zmk/endpoints.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/profiles.h>
+#endif
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_reports_sent,
+                                   "reports_sent");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_reports_failed,
+                                   "reports_failed");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_notify_no_buffer,
+                                   "notify_no_buffer");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_notify_failed,
+                                   "notify_failed");
+
+static struct zmk_ble_mgmt_report_stats usb_stats;
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+static struct zmk_ble_mgmt_report_stats ble_stats[ZMK_BLE_PROFILE_COUNT];
+#endif
+
+void zmk_ble_mgmt_report_stats_on_send(
+    const struct zmk_endpoint_instance *endpoint, int rc) {
+    struct zmk_ble_mgmt_report_stats *stats = NULL;
+    switch (endpoint->transport) {
+        case ZMK_TRANSPORT_USB:
+            stats = &usb_stats;
+            break;
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+        case ZMK_TRANSPORT_BLE:
+            if (endpoint->ble.profile_index >= 0 &&
+                endpoint->ble.profile_index < ZMK_BLE_PROFILE_COUNT) {
+                stats = &ble_stats[endpoint->ble.profile_index];
+            }
+            break;
+#endif
+        default:
+            break;
+    }
+
+    if (stats) {
+        if (rc == 0) {
+            stats->sent++;
+            ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_reports_sent);
+        } else {
+            stats->failed++;
+            ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_reports_failed);
+        }
+    }
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+void zmk_ble_mgmt_report_stats_on_notify(
+    struct bt_conn *conn, const struct bt_gatt_notify_params *params, int rc) {
+    if (rc == 0 || !conn || !params->attr ||
+        bt_uuid_cmp(params->attr->uuid, BT_UUID_HIDS_REPORT) != 0) {
+        return;
+    }
+
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile < 0) {
+        return;
+    }
+
+    if (rc == -ENOMEM) {
+        ble_stats[profile].no_buffer++;
+        ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_notify_no_buffer);
+    } else {
+        ble_stats[profile].notify_failed++;
+        ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_notify_failed);
+    }
+    LOG_DBG("HID notification to profile %d failed: %d", profile, rc);
+}
+#endif
+
+int zmk_ble_mgmt_report_stats_get_usb(struct zmk_ble_mgmt_report_stats *stats) {
+    if (!stats) {
+        return -EINVAL;
+    }
+
+    *stats = usb_stats;
+    return 0;
+}
+
+int zmk_ble_mgmt_report_stats_get_ble(uint8_t profile,
+                                      struct zmk_ble_mgmt_report_stats *stats) {
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    if (profile >= ZMK_BLE_PROFILE_COUNT || !stats) {
+        return -EINVAL;
+    }
+
+    *stats = ble_stats[profile];
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+void zmk_ble_mgmt_report_stats_reset(void) {
+    memset(&usb_stats, 0, sizeof(usb_stats));
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    memset(ble_stats, 0, sizeof(ble_stats));
+#endif
+}
@@ -0,0 +1,223 @@
+/**
+ * BLE Management Feature - Settings write accounting and wear budget
+ *
+ * Every ble_mgmt setting is persisted through zmk_ble_mgmt_settings_save() or
+ * zmk_ble_mgmt_settings_delete(), which count writes and bytes per key class
+ * and refuse saves once a token bucket rate limit is exhausted. Deletes are
+ * never refused: a refused delete would leave a stale record in flash.
+ *
+ * Remaining endurance of the storage partition is estimated from the flash
+ * bytes written over the device lifetime (value plus per-record overhead of
+ * the log structured backend) against partition size times the erase
+ * endurance. Only ble_mgmt writes are seen, so the estimate is an upper
+ * bound. The lifetime total is persisted under "ble_mgmt/wear" every few
+ * writes.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
+#include <zmk/ble_management/boot_profile.h>
+#include <zmk/ble_management/lazy_settings.h>
+#include <zmk/ble_management/settings_wear.h>
+#include <zmk/ble_management/tracing.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Allocation table entry and write block alignment of NVS on nRF52
+#define RECORD_OVERHEAD 8
+#define WRITE_ALIGN     4
+
+// Writes between saves of the lifetime total
+#define PERSIST_EVERY 16
+
+#define RATE_BURST     CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR_RATE_BURST
+#define RATE_REFILL_MS CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR_RATE_REFILL_MS
+
+#if FIXED_PARTITION_EXISTS(storage_partition)
+#define PARTITION_SIZE FIXED_PARTITION_SIZE(storage_partition)
+#else
+#define PARTITION_SIZE 0
+#endif
+
+static const char *const class_prefixes[] = {
+    [ZMK_BLE_MGMT_SETTINGS_NAME]       = "ble_mgmt/name/",
+    [ZMK_BLE_MGMT_SETTINGS_SCHED]      = "ble_mgmt/sched/",
+    [ZMK_BLE_MGMT_SETTINGS_STO]        = "ble_mgmt/sto/",
+    [ZMK_BLE_MGMT_SETTINGS_SPLIT_LINK] = "ble_mgmt/split_link/",
+};
+
+static struct zmk_ble_mgmt_settings_class_stats
+    class_stats[ZMK_BLE_MGMT_SETTINGS_CLASS_COUNT];
+static uint32_t lifetime_flash_bytes;
+static uint32_t unpersisted_writes;
+
+static uint32_t tokens = RATE_BURST;
+static int64_t last_refill;
+
+static K_MUTEX_DEFINE(wear_mutex);
+
+static enum zmk_ble_mgmt_settings_class classify(const char *name) {
+    for (int i = 0; i < ARRAY_SIZE(class_prefixes); i++) {
+        if (class_prefixes[i] &&
+            strncmp(name, class_prefixes[i], strlen(class_prefixes[i])) == 0) {
+            return i;
+        }
+    }
+    return ZMK_BLE_MGMT_SETTINGS_OTHER;
+}
+
+static void refill_tokens(void) {
+    int64_t now = k_uptime_get();
+    if (tokens >= RATE_BURST) {
+        last_refill = now;
+        return;
+    }
+
+    uint32_t refill = (now - last_refill) / RATE_REFILL_MS;
+    if (refill > 0) {
+        tokens = MIN(tokens + refill, RATE_BURST);
+        last_refill += (int64_t)refill * RATE_REFILL_MS;
+    }
+}
+
+/**
+ * Take a rate limit token for a write of the given class.
+ * Must be called with wear_mutex held.
+ */
+static bool take_token(enum zmk_ble_mgmt_settings_class cls) {
+    if (RATE_BURST == 0) {
+        return true;
+    }
+
+    refill_tokens();
+    if (tokens == 0) {
+        class_stats[cls].rate_limited++;
+        return false;
+    }
+    tokens--;
+    return true;
+}
+
+/**
+ * Account a completed write and persist the lifetime total when due.
+ * Must be called with wear_mutex held.
+ */
+static void account_write(enum zmk_ble_mgmt_settings_class cls, size_t len) {
+    class_stats[cls].writes++;
+    class_stats[cls].bytes += len;
+    lifetime_flash_bytes += ROUND_UP(len, WRITE_ALIGN) + RECORD_OVERHEAD;
+
+    // Saving before the stored total is loaded would overwrite it
+    if (++unpersisted_writes < PERSIST_EVERY ||
+        zmk_ble_mgmt_settings_deferred()) {
+        return;
+    }
+
+    // The total itself costs a record too
+    lifetime_flash_bytes +=
+        ROUND_UP(sizeof(lifetime_flash_bytes), WRITE_ALIGN) + RECORD_OVERHEAD;
+    int rc = settings_save_one("ble_mgmt/wear", &lifetime_flash_bytes,
+                               sizeof(lifetime_flash_bytes));
+    if (rc < 0) {
+        LOG_WRN("Failed to save settings wear total: %d", rc);
+        return;
+    }
+    unpersisted_writes = 0;
+}
+
+int zmk_ble_mgmt_settings_save(const char *name, const void *value,
+                               size_t len) {
+    enum zmk_ble_mgmt_settings_class cls = classify(name);
+
+    k_mutex_lock(&wear_mutex, K_FOREVER);
+    if (!take_token(cls)) {
+        k_mutex_unlock(&wear_mutex);
+        LOG_WRN("Settings write rate limit reached, not saving %s", name);
+        return -EBUSY;
+    }
+
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_IN, len, 0);
+    int rc = settings_save_one(name, value, len);
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_OUT, len, rc);
+    if (rc == 0) {
+        account_write(cls, len);
+    }
+    k_mutex_unlock(&wear_mutex);
+    return rc;
+}
+
+int zmk_ble_mgmt_settings_delete(const char *name) {
+    enum zmk_ble_mgmt_settings_class cls = classify(name);
+
+    k_mutex_lock(&wear_mutex, K_FOREVER);
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_IN, 0, 0);
+    int rc = settings_delete(name);
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SETTINGS_OUT, 0, rc);
+    if (rc == 0) {
+        account_write(cls, 0);
+    }
+    k_mutex_unlock(&wear_mutex);
+    return rc;
+}
+
+int zmk_ble_mgmt_settings_wear_get(struct zmk_ble_mgmt_settings_wear *wear) {
+    if (!wear) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&wear_mutex, K_FOREVER);
+    memcpy(wear->classes, class_stats, sizeof(class_stats));
+    wear->lifetime_flash_bytes = lifetime_flash_bytes;
+    if (RATE_BURST == 0) {
+        wear->tokens = UINT32_MAX;
+    } else {
+        refill_tokens();
+        wear->tokens = tokens;
+    }
+    k_mutex_unlock(&wear_mutex);
+
+    wear->partition_size     = PARTITION_SIZE;
+    wear->remaining_permille = 0;
+    if (PARTITION_SIZE > 0) {
+        uint64_t budget =
+            (uint64_t)PARTITION_SIZE *
+            CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR_ENDURANCE_CYCLES;
+        uint64_t used = (uint64_t)wear->lifetime_flash_bytes * 1000 / budget;
+        wear->remaining_permille = used >= 1000 ? 0 : 1000 - used;
+    }
+    return 0;
+}
+
+/**
+ * Settings callback for loading the lifetime write total
+ */
+static int settings_wear_set(const char *name, size_t len,
+                             settings_read_cb read_cb, void *cb_arg) {
+    if (zmk_ble_mgmt_settings_deferred()) {
+        return 0;
+    }
+
+    uint32_t begin = zmk_ble_mgmt_boot_profile_begin();
+    uint32_t total;
+    if (len != sizeof(total)) {
+        LOG_WRN("Invalid settings wear total size: %zu", len);
+        return 0;
+    }
+
+    int rc = read_cb(cb_arg, &total, sizeof(total));
+    if (rc >= 0) {
+        // Writes made before a deferred load have not been saved yet
+        k_mutex_lock(&wear_mutex, K_FOREVER);
+        lifetime_flash_bytes += total;
+        k_mutex_unlock(&wear_mutex);
+    }
+    zmk_ble_mgmt_boot_profile_record_done(begin);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(ble_mgmt_wear, "ble_mgmt/wear", NULL,
+                               settings_wear_set, NULL, NULL);
@@ -0,0 +1,364 @@
+/**
+ * BLE Management Feature - Split peripheral link parameter tuning
+ *
+ * The central owns the link to each split peripheral, so it can change the
+ * connection interval, latency and PHY of that link at runtime instead of
+ * only through ZMK's build-time defaults. Parameters are persisted per
+ * peripheral slot under "ble_mgmt/split_link/<slot>" and re-applied a short
+ * while after every reconnect, once ZMK finished its own negotiation.
+ *
+ * To show the effect of a change, the round trip time of GATT reads of the
+ * peripheral's device name is probed before the new parameters are requested
+ * and again once the link reports the update. Half the round trip
+ * approximates the latency the split hop adds to each key.
+ */
+
+#include <stdlib.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/ble_management/boot_profile.h>
+#include <zmk/ble_management/lazy_settings.h>
+#include <zmk/ble_management/settings_wear.h>
+#include <zmk/ble_management/split_link.h>
+#include <zmk/ble_management/split_peripherals.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define APPLY_DELAY K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_LINK_APPLY_DELAY_MS)
+
+// Reads per probe, and how long to wait for the link to report an update
+#define PROBE_SAMPLES  8
+#define UPDATE_TIMEOUT K_SECONDS(5)
+
+enum probe_phase {
+    PROBE_IDLE,
+    PROBE_BEFORE,
+    PROBE_APPLYING,
+    PROBE_AFTER,
+};
+
+static struct zmk_ble_mgmt_split_link_state
+    states[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+
+static struct {
+    enum probe_phase phase;
+    uint8_t slot;
+    struct bt_conn *conn;
+    uint8_t attempts;
+    bool read_pending;
+    uint32_t sent_at;
+    uint64_t total_us;
+    struct zmk_ble_mgmt_split_link_probe result;
+    struct bt_gatt_read_params read_params;
+} probe;
+
+static void probe_work_handler(struct k_work *work);
+static void apply_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(probe_work, probe_work_handler);
+static K_WORK_DELAYABLE_DEFINE(apply_work, apply_work_handler);
+
+static bool params_are_valid(const struct zmk_ble_mgmt_split_link_params *p) {
+    // Supervision timeout must exceed (1 + latency) * interval * 2
+    uint32_t period = (1 + p->latency) * p->interval;
+
+    return p->interval >= 6 && p->interval <= 3200 && p->latency <= 499 &&
+           p->timeout >= 10 && p->timeout <= 3200 &&
+           period < p->timeout * 4 &&
+           (p->phy == 0 || p->phy == BT_GAP_LE_PHY_1M ||
+            p->phy == BT_GAP_LE_PHY_2M || p->phy == BT_GAP_LE_PHY_CODED);
+}
+
+static void request_params(struct bt_conn *conn,
+                           const struct zmk_ble_mgmt_split_link_params *p) {
+    struct bt_le_conn_param param =
+        BT_LE_CONN_PARAM_INIT(p->interval, p->interval, p->latency, p->timeout);
+    int rc = bt_conn_le_param_update(conn, &param);
+    if (rc < 0 && rc != -EALREADY) {
+        LOG_WRN("Failed to request split link parameters: %d", rc);
+    }
+
+    if (p->phy != 0) {
+        struct bt_conn_le_phy_param phy = {
+            .options     = BT_CONN_LE_PHY_OPT_NONE,
+            .pref_tx_phy = p->phy,
+            .pref_rx_phy = p->phy,
+        };
+        rc = bt_conn_le_phy_update(conn, &phy);
+        if (rc < 0 && rc != -EALREADY) {
+            LOG_WRN("Failed to request split link PHY: %d", rc);
+        }
+    }
+}
+
+static void probe_stop(void) {
+    k_work_cancel_delayable(&probe_work);
+    if (probe.conn) {
+        bt_conn_unref(probe.conn);
+        probe.conn = NULL;
+    }
+    probe.phase        = PROBE_IDLE;
+    probe.read_pending = false;
+}
+
+static void probe_begin_phase(enum probe_phase phase) {
+    probe.phase    = phase;
+    probe.attempts = 0;
+    probe.total_us = 0;
+    probe.result   = (struct zmk_ble_mgmt_split_link_probe){0};
+    k_work_reschedule(&probe_work, K_NO_WAIT);
+}
+
+static uint8_t probe_read_cb(struct bt_conn *conn, uint8_t err,
+                             struct bt_gatt_read_params *params,
+                             const void *data, uint16_t length) {
+    if (!probe.read_pending) {
+        return BT_GATT_ITER_STOP;
+    }
+    probe.read_pending = false;
+
+    if (!err) {
+        uint32_t rtt_us = k_cyc_to_us_floor32(k_cycle_get_32() - probe.sent_at);
+        struct zmk_ble_mgmt_split_link_probe *r = &probe.result;
+        if (r->samples == 0 || rtt_us < r->min_us) {
+            r->min_us = rtt_us;
+        }
+        if (rtt_us > r->max_us) {
+            r->max_us = rtt_us;
+        }
+        r->samples++;
+        probe.total_us += rtt_us;
+    }
+
+    k_work_reschedule(&probe_work, K_NO_WAIT);
+    return BT_GATT_ITER_STOP;
+}
+
+static void probe_send_read(void) {
+    probe.read_params = (struct bt_gatt_read_params){
+        .func         = probe_read_cb,
+        .handle_count = 0,
+        .by_uuid =
+            {
+                .uuid         = BT_UUID_GAP_DEVICE_NAME,
+                .start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE,
+                .end_handle   = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+            },
+    };
+
+    probe.attempts++;
+    probe.read_pending = true;
+    probe.sent_at      = k_cycle_get_32();
+    int rc             = bt_gatt_read(probe.conn, &probe.read_params);
+    if (rc < 0) {
+        LOG_DBG("Split link probe read failed: %d", rc);
+        probe.read_pending = false;
+        k_work_reschedule(&probe_work, K_MSEC(10));
+    }
+}
+
+static void probe_work_handler(struct k_work *work) {
+    struct zmk_ble_mgmt_split_link_state *state = &states[probe.slot];
+
+    switch (probe.phase) {
+        case PROBE_BEFORE:
+        case PROBE_AFTER:
+            if (probe.read_pending) {
+                return;
+            }
+            if (probe.result.samples < PROBE_SAMPLES &&
+                probe.attempts < PROBE_SAMPLES * 2) {
+                probe_send_read();
+                return;
+            }
+
+            if (probe.result.samples > 0) {
+                probe.result.avg_us = probe.total_us / probe.result.samples;
+            }
+            if (probe.phase == PROBE_BEFORE) {
+                state->before = probe.result;
+                request_params(probe.conn, &state->params);
+                probe.phase = PROBE_APPLYING;
+                k_work_reschedule(&probe_work, UPDATE_TIMEOUT);
+            } else {
+                state->after = probe.result;
+                LOG_DBG("Split link %d round trip %u us -> %u us", probe.slot,
+                        state->before.avg_us, state->after.avg_us);
+                probe_stop();
+            }
+            break;
+        case PROBE_APPLYING:
+            // Updated, or the link kept its parameters
+            probe_begin_phase(PROBE_AFTER);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Request the configured parameters on every connected peripheral slot
+ */
+static void apply_work_handler(struct k_work *work) {
+    for (uint8_t i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+        if (!states[i].configured ||
+            (probe.phase != PROBE_IDLE && probe.slot == i)) {
+            continue;
+        }
+
+        struct bt_conn *conn = zmk_ble_mgmt_split_peripheral_conn(i);
+        if (conn) {
+            request_params(conn, &states[i].params);
+            bt_conn_unref(conn);
+        }
+    }
+}
+
+static void split_link_connected(struct bt_conn *conn, uint8_t err) {
+    struct bt_conn_info info;
+    if (!err && bt_conn_get_info(conn, &info) == 0 &&
+        info.role == BT_CONN_ROLE_CENTRAL) {
+        // Let ZMK finish its own parameter negotiation first
+        k_work_reschedule(&apply_work, APPLY_DELAY);
+    }
+}
+
+static void split_link_disconnected(struct bt_conn *conn, uint8_t reason) {
+    if (probe.phase != PROBE_IDLE && probe.conn == conn) {
+        LOG_DBG("Split link %d disconnected during probe", probe.slot);
+        probe_stop();
+    }
+}
+
+static void split_link_le_param_updated(struct bt_conn *conn,
+                                        uint16_t interval, uint16_t latency,
+                                        uint16_t timeout) {
+    if (probe.phase == PROBE_APPLYING && probe.conn == conn) {
+        k_work_reschedule(&probe_work, K_NO_WAIT);
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_split_link_conn_cb) = {
+    .connected        = split_link_connected,
+    .disconnected     = split_link_disconnected,
+    .le_param_updated = split_link_le_param_updated,
+};
+
+int zmk_ble_mgmt_split_link_get(uint8_t slot,
+                                struct zmk_ble_mgmt_split_link_state *state) {
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT || !state) {
+        return -EINVAL;
+    }
+
+    *state           = states[slot];
+    state->connected = false;
+    state->current   = (struct zmk_ble_mgmt_split_link_params){0};
+
+    struct bt_conn *conn = zmk_ble_mgmt_split_peripheral_conn(slot);
+    if (conn) {
+        struct bt_conn_info info;
+        if (bt_conn_get_info(conn, &info) == 0) {
+            state->connected        = true;
+            state->current.interval = info.le.interval;
+            state->current.latency  = info.le.latency;
+            state->current.timeout  = info.le.timeout;
+            state->current.phy      = info.le.phy->tx_phy;
+        }
+        bt_conn_unref(conn);
+    }
+    return 0;
+}
+
+int zmk_ble_mgmt_split_link_set(
+    uint8_t slot, const struct zmk_ble_mgmt_split_link_params *params) {
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT ||
+        (params && !params_are_valid(params))) {
+        return -EINVAL;
+    }
+
+    char setting_name[32];
+    snprintf(setting_name, sizeof(setting_name), "ble_mgmt/split_link/%d",
+             slot);
+
+    if (!params) {
+        // The live link keeps its parameters until ZMK reconnects
+        states[slot].configured = false;
+        return zmk_ble_mgmt_settings_delete(setting_name);
+    }
+
+    int rc = zmk_ble_mgmt_settings_save(setting_name, params, sizeof(*params));
+    if (rc < 0) {
+        return rc;
+    }
+    states[slot].configured = true;
+    states[slot].params     = *params;
+
+    struct bt_conn *conn = zmk_ble_mgmt_split_peripheral_conn(slot);
+    if (!conn) {
+        return 0;
+    }
+
+    if (probe.phase != PROBE_IDLE) {
+        // Another change is being measured; apply without measuring
+        request_params(conn, params);
+        bt_conn_unref(conn);
+        return 0;
+    }
+
+    states[slot].before = (struct zmk_ble_mgmt_split_link_probe){0};
+    states[slot].after  = (struct zmk_ble_mgmt_split_link_probe){0};
+    probe.slot          = slot;
+    probe.conn          = conn;
+    probe_begin_phase(PROBE_BEFORE);
+    return 0;
+}
+
+/**
+ * Settings callback for loading per-slot parameters
+ */
+static int split_link_settings_set(const char *name, size_t len,
+                                   settings_read_cb read_cb, void *cb_arg) {
+    if (zmk_ble_mgmt_settings_deferred()) {
+        return 0;
+    }
+
+    uint32_t begin = zmk_ble_mgmt_boot_profile_begin();
+    char *end;
+    unsigned long slot = strtoul(name, &end, 10);
+    if (end == name || *end != '\0' ||
+        slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT) {
+        LOG_WRN("Unknown split link setting: %s", name);
+        return 0;
+    }
+
+    struct zmk_ble_mgmt_split_link_params params;
+    if (len != sizeof(params)) {
+        LOG_WRN("Invalid split link setting size: %zu", len);
+        return 0;
+    }
+
+    int rc = read_cb(cb_arg, &params, sizeof(params));
+    if (rc >= 0 && params_are_valid(&params)) {
+        states[slot].configured = true;
+        states[slot].params     = params;
+    }
+    zmk_ble_mgmt_boot_profile_record_done(begin);
+    return 0;
+}
+
+/**
+ * Settings callback invoked once parameters are loaded, which may be after
+ * peripherals connected when loading is deferred
+ */
+static int split_link_settings_commit(void) {
+    k_work_reschedule(&apply_work, K_NO_WAIT);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(ble_mgmt_split_link, "ble_mgmt/split_link",
+                               NULL, split_link_settings_set,
+                               split_link_settings_commit, NULL);
@@ -0,0 +1,296 @@
+/**
+ * BLE Management Feature - Split peripheral state on the central
+ *
+ * Reports every peripheral slot of the split central (one for a classic
+ * split, two or more for dongles and multi-part boards). ZMK keeps the
+ * bonded peripheral addresses private, so they are read back from ZMK's own
+ * "ble/peripheral_addresses/<slot>" records with settings_load_subtree_direct()
+ * without registering a handler. One scan reads every slot and the result is
+ * cached until a peripheral connects or disconnects, which is when ZMK
+ * writes or deletes those records. Link parameters come from the live
+ * connection and the battery level from the last peripheral battery event.
+ * Connections and disconnects are counted per peripheral address so flaky
+ * halves show up as reconnects with their last disconnect reason.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+#include <zmk/ble_management/split_peripherals.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/battery_state_changed.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+struct battery_entry {
+    bool known;
+    uint8_t level;
+};
+
+// Link history of a peripheral address, kept by address since the BT
+// callbacks cannot cheaply map a connection to its slot
+struct link_history {
+    bt_addr_le_t addr;
+    uint32_t connects;
+    uint32_t disconnects;
+    uint8_t last_reason;
+    int64_t last_disconnect_at;
+};
+
+static struct battery_entry batteries[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+static struct link_history histories[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+
+// Bumped on every peripheral connect and disconnect; the cached addresses
+// are current while cached_generation matches it. The scan runs without a
+// lock held (callers may hold the settings lock), so an update during a
+// scan leaves the cache stale for the next caller.
+static atomic_t addrs_generation;
+static atomic_val_t cached_generation = -1;
+static bt_addr_le_t cached_addrs[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+static struct k_spinlock cached_addrs_lock;
+
+static int split_peripherals_listener(const zmk_event_t *eh) {
+    const struct zmk_peripheral_battery_state_changed *ev =
+        as_zmk_peripheral_battery_state_changed(eh);
+    if (ev && ev->source < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT) {
+        batteries[ev->source].known = true;
+        batteries[ev->source].level = ev->state_of_charge;
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ble_mgmt_split_peripherals, split_peripherals_listener);
+ZMK_SUBSCRIPTION(ble_mgmt_split_peripherals,
+                 zmk_peripheral_battery_state_changed);
+
+/**
+ * Find the history of an address, optionally taking over the least used
+ * entry for an address seen for the first time.
+ */
+static struct link_history *history_for(const bt_addr_le_t *addr,
+                                        bool create) {
+    struct link_history *spare = NULL;
+    for (int i = 0; i < ARRAY_SIZE(histories); i++) {
+        if (bt_addr_le_eq(&histories[i].addr, addr)) {
+            return &histories[i];
+        }
+        if (!spare || histories[i].connects < spare->connects) {
+            spare = &histories[i];
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+
+    *spare = (struct link_history){0};
+    bt_addr_le_copy(&spare->addr, addr);
+    return spare;
+}
+
+static bool is_peripheral_link(struct bt_conn *conn) {
+    struct bt_conn_info info;
+    return bt_conn_get_info(conn, &info) == 0 &&
+           info.role == BT_CONN_ROLE_CENTRAL;
+}
+
+static void split_peripherals_connected(struct bt_conn *conn, uint8_t err) {
+    if (err || !is_peripheral_link(conn)) {
+        return;
+    }
+    atomic_inc(&addrs_generation);
+    history_for(bt_conn_get_dst(conn), true)->connects++;
+}
+
+static void split_peripherals_disconnected(struct bt_conn *conn,
+                                           uint8_t reason) {
+    if (!is_peripheral_link(conn)) {
+        return;
+    }
+    atomic_inc(&addrs_generation);
+
+    struct link_history *history = history_for(bt_conn_get_dst(conn), true);
+    history->disconnects++;
+    history->last_reason        = reason;
+    history->last_disconnect_at = k_uptime_get();
+    LOG_DBG("Split peripheral disconnected (reason 0x%02x)", reason);
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_split_peripherals_conn_cb) = {
+    .connected    = split_peripherals_connected,
+    .disconnected = split_peripherals_disconnected,
+};
+
+static int peripheral_addr_loaded(const char *key, size_t len,
+                                  settings_read_cb read_cb, void *cb_arg,
+                                  void *param) {
+    bt_addr_le_t *addrs = param;
+    char *end;
+
+    if (!key) {
+        return 0;
+    }
+
+    unsigned long slot = strtoul(key, &end, 10);
+    if (end == key || *end != '\0' ||
+        slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT ||
+        len != sizeof(bt_addr_le_t)) {
+        return 0;
+    }
+
+    if (read_cb(cb_arg, &addrs[slot], sizeof(addrs[slot])) < 0) {
+        bt_addr_le_copy(&addrs[slot], BT_ADDR_LE_ANY);
+    }
+    return 0;
+}
+
+/**
+ * Copy the bonded address of every slot (BT_ADDR_LE_ANY if empty), scanning
+ * ZMK's records only if a peripheral connected or disconnected since the
+ * last scan.
+ */
+static int load_addrs(bt_addr_le_t addrs[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT]) {
+    atomic_val_t generation = atomic_get(&addrs_generation);
+    bool cached             = false;
+
+    K_SPINLOCK(&cached_addrs_lock) {
+        if (cached_generation == generation) {
+            memcpy(addrs, cached_addrs, sizeof(cached_addrs));
+            cached = true;
+        }
+    }
+    if (cached) {
+        return 0;
+    }
+
+    for (int i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+        bt_addr_le_copy(&addrs[i], BT_ADDR_LE_ANY);
+    }
+    int rc = settings_load_subtree_direct("ble/peripheral_addresses",
+                                          peripheral_addr_loaded, addrs);
+    if (rc < 0) {
+        LOG_WRN("Failed to read split peripheral addresses: %d", rc);
+        return rc;
+    }
+
+    K_SPINLOCK(&cached_addrs_lock) {
+        memcpy(cached_addrs, addrs, sizeof(cached_addrs));
+        cached_generation = generation;
+    }
+    return 0;
+}
+
+void zmk_ble_mgmt_split_peripherals_invalidate(void) {
+    atomic_inc(&addrs_generation);
+}
+
+int zmk_ble_mgmt_split_peripheral_addr(uint8_t slot, bt_addr_le_t *addr) {
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT || !addr) {
+        return -EINVAL;
+    }
+
+    bt_addr_le_t addrs[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+    int rc = load_addrs(addrs);
+    if (rc < 0) {
+        return rc;
+    }
+    if (bt_addr_le_eq(&addrs[slot], BT_ADDR_LE_ANY)) {
+        return -ENOENT;
+    }
+
+    bt_addr_le_copy(addr, &addrs[slot]);
+    return 0;
+}
+
+int zmk_ble_mgmt_split_peripheral_slot(const bt_addr_le_t *addr) {
+    if (!addr) {
+        return -EINVAL;
+    }
+
+    bt_addr_le_t addrs[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+    int rc = load_addrs(addrs);
+    if (rc < 0) {
+        return rc;
+    }
+
+    for (uint8_t i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+        if (!bt_addr_le_eq(&addrs[i], BT_ADDR_LE_ANY) &&
+            bt_addr_le_eq(&addrs[i], addr)) {
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+struct bt_conn *zmk_ble_mgmt_split_peripheral_conn(uint8_t slot) {
+    bt_addr_le_t addr;
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT ||
+        zmk_ble_mgmt_split_peripheral_addr(slot, &addr) < 0) {
+        return NULL;
+    }
+
+    struct bt_conn *conn = bt_conn_lookup_addr_le(BT_ID_DEFAULT, &addr);
+    if (!conn) {
+        return NULL;
+    }
+
+    struct bt_conn_info info;
+    if (bt_conn_get_info(conn, &info) != 0 ||
+        info.role != BT_CONN_ROLE_CENTRAL ||
+        info.state != BT_CONN_STATE_CONNECTED) {
+        bt_conn_unref(conn);
+        return NULL;
+    }
+    return conn;
+}
+
+int zmk_ble_mgmt_split_peripheral_get(
+    uint8_t slot, struct zmk_ble_mgmt_split_peripheral *peripheral) {
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT || !peripheral) {
+        return -EINVAL;
+    }
+
+    *peripheral = (struct zmk_ble_mgmt_split_peripheral){
+        .battery_known = batteries[slot].known,
+        .battery_level = batteries[slot].level,
+    };
+    bt_addr_le_copy(&peripheral->addr, BT_ADDR_LE_ANY);
+
+    int rc = zmk_ble_mgmt_split_peripheral_addr(slot, &peripheral->addr);
+    if (rc == -ENOENT) {
+        return 0;
+    } else if (rc < 0) {
+        return rc;
+    }
+    peripheral->bonded = true;
+
+    const struct link_history *history = history_for(&peripheral->addr, false);
+    if (history) {
+        peripheral->reconnects =
+            history->connects > 0 ? history->connects - 1 : 0;
+        peripheral->disconnects            = history->disconnects;
+        peripheral->last_disconnect_reason = history->last_reason;
+        if (history->disconnects > 0) {
+            peripheral->last_disconnect_age_s =
+                (k_uptime_get() - history->last_disconnect_at) / MSEC_PER_SEC;
+        }
+    }
+
+    struct bt_conn *conn = zmk_ble_mgmt_split_peripheral_conn(slot);
+    if (!conn) {
+        return 0;
+    }
+
+    struct bt_conn_info info;
+    if (bt_conn_get_info(conn, &info) == 0) {
+        peripheral->connected = true;
+        peripheral->interval  = info.le.interval;
+        peripheral->latency   = info.le.latency;
+        peripheral->timeout   = info.le.timeout;
+    }
+    bt_conn_unref(conn);
+    return 0;
+}
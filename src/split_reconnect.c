@@ -0,0 +1,268 @@
+/**
+ * BLE Management Feature - Split reconnect timing and fast reconnect mode
+ *
+ * Measures how long the split link takes to come back, from boot to the
+ * first split connection and from every split disconnect to the next
+ * connection of the same peer, into a histogram. On the central the split
+ * link is any link where we are the BLE central; a peripheral only ever
+ * connects to the central.
+ *
+ * Fast reconnect mode trades power for a shorter gap. ZMK already uses high
+ * duty directed advertising right after a bonded peripheral loses its link;
+ * the mode shortens what follows it:
+ * - central: scan continuously (window = interval) and, once every slot is
+ *   bonded, only for the bonded peripherals using the filter accept list
+ * - peripheral: advertise connectable at the 30-60 ms fast interval
+ * Parameters are swapped in by the scan/advertising link-time hooks. The
+ * mode is persisted under "ble_mgmt/fast_reconnect" on each half.
+ */
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/ble_management/boot_profile.h>
+#include <zmk/ble_management/lazy_settings.h>
+#include <zmk/ble_management/settings_wear.h>
+#include <zmk/ble_management/split_reconnect.h>
+
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+#include <zmk/ble_management/split_peripherals.h>
+#endif
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Connectable advertising interval in fast mode (30-60 ms)
+#define FAST_ADV_INT_MIN BT_GAP_ADV_FAST_INT_MIN_1
+#define FAST_ADV_INT_MAX BT_GAP_ADV_FAST_INT_MAX_1
+
+const uint32_t zmk_ble_mgmt_split_reconnect_bounds[] = {
+    100, 250, 500, 1000, 2000, 3000, 5000, 10000, 30000, UINT32_MAX,
+};
+
+BUILD_ASSERT(ARRAY_SIZE(zmk_ble_mgmt_split_reconnect_bounds) ==
+             ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS);
+
+static struct zmk_ble_mgmt_split_reconnect_stats stats;
+static bool fast_reconnect;
+
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+#define PEER_COUNT ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT
+#else
+#define PEER_COUNT 1
+#endif
+
+// Last split disconnect of a peer, kept by address so peripherals that drop
+// at the same time are timed separately
+struct peer_gap {
+    bt_addr_le_t addr;
+    int64_t disconnected_at;  // Uptime, 0 while connected
+};
+
+static struct peer_gap gaps[PEER_COUNT];
+
+/**
+ * Find the gap of a peer, optionally taking over a closed or the oldest
+ * entry for a peer that was not seen yet.
+ */
+static struct peer_gap *gap_for(const bt_addr_le_t *addr, bool create) {
+    struct peer_gap *spare = NULL;
+    for (int i = 0; i < ARRAY_SIZE(gaps); i++) {
+        if (bt_addr_le_eq(&gaps[i].addr, addr)) {
+            return &gaps[i];
+        }
+        if (!spare || gaps[i].disconnected_at < spare->disconnected_at) {
+            spare = &gaps[i];
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+
+    bt_addr_le_copy(&spare->addr, addr);
+    spare->disconnected_at = 0;
+    return spare;
+}
+
+static bool is_split_link(struct bt_conn *conn) {
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    struct bt_conn_info info;
+    return bt_conn_get_info(conn, &info) == 0 &&
+           info.role == BT_CONN_ROLE_CENTRAL;
+#else
+    return true;
+#endif
+}
+
+static void record_reconnect(uint32_t elapsed_ms) {
+    stats.reconnects++;
+    stats.last_ms = elapsed_ms;
+    stats.max_ms  = MAX(stats.max_ms, elapsed_ms);
+    for (int i = 0; i < ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS; i++) {
+        if (elapsed_ms < zmk_ble_mgmt_split_reconnect_bounds[i] ||
+            i == ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS - 1) {
+            stats.counts[i]++;
+            break;
+        }
+    }
+}
+
+static void split_reconnect_connected(struct bt_conn *conn, uint8_t err) {
+    if (err || !is_split_link(conn)) {
+        return;
+    }
+
+    int64_t now = k_uptime_get();
+    if (stats.boot_connect_ms == 0) {
+        stats.boot_connect_ms = MAX(now, 1);
+    }
+
+    struct peer_gap *gap = gap_for(bt_conn_get_dst(conn), false);
+    if (gap && gap->disconnected_at != 0) {
+        uint32_t elapsed = now - gap->disconnected_at;
+        record_reconnect(elapsed);
+        LOG_DBG("Split link reconnected after %u ms", elapsed);
+        gap->disconnected_at = 0;
+    }
+}
+
+static void split_reconnect_disconnected(struct bt_conn *conn,
+                                         uint8_t reason) {
+    if (is_split_link(conn)) {
+        gap_for(bt_conn_get_dst(conn), true)->disconnected_at =
+            k_uptime_get();
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_split_reconnect_conn_cb) = {
+    .connected    = split_reconnect_connected,
+    .disconnected = split_reconnect_disconnected,
+};
+
+int zmk_ble_mgmt_split_reconnect_get_stats(
+    struct zmk_ble_mgmt_split_reconnect_stats *out) {
+    if (!out) {
+        return -EINVAL;
+    }
+
+    *out = stats;
+    return 0;
+}
+
+bool zmk_ble_mgmt_split_reconnect_get_fast(void) { return fast_reconnect; }
+
+int zmk_ble_mgmt_split_reconnect_set_fast(bool enabled) {
+    if (enabled == fast_reconnect) {
+        return 0;
+    }
+
+    uint8_t value = enabled;
+    int rc = zmk_ble_mgmt_settings_save("ble_mgmt/fast_reconnect", &value,
+                                        sizeof(value));
+    if (rc < 0) {
+        return rc;
+    }
+
+    // Takes effect the next time ZMK starts scanning or advertising
+    fast_reconnect = enabled;
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+/**
+ * Limit scanning to the bonded peripherals. Slots still waiting to be paired
+ * need to be discoverable, so the list is only used once all are bonded.
+ */
+static bool fill_accept_list(void) {
+    bt_addr_le_t addrs[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+    for (uint8_t i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+        if (zmk_ble_mgmt_split_peripheral_addr(i, &addrs[i]) < 0) {
+            return false;
+        }
+    }
+
+    int rc = bt_le_filter_accept_list_clear();
+    for (uint8_t i = 0; rc == 0 && i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT;
+         i++) {
+        rc = bt_le_filter_accept_list_add(&addrs[i]);
+    }
+    if (rc < 0) {
+        LOG_WRN("Failed to fill the filter accept list: %d", rc);
+        bt_le_filter_accept_list_clear();
+        return false;
+    }
+    return true;
+}
+#endif
+
+const struct bt_le_scan_param *
+zmk_ble_mgmt_split_reconnect_scan_param(const struct bt_le_scan_param *param,
+                                        struct bt_le_scan_param *buf) {
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    if (!fast_reconnect || !param) {
+        return param;
+    }
+
+    *buf        = *param;
+    buf->window = buf->interval;
+    if (fill_accept_list()) {
+        buf->options |= BT_LE_SCAN_OPT_FILTER_ACCEPT_LIST;
+    }
+    return buf;
+#else
+    return param;
+#endif
+}
+
+const struct bt_le_adv_param *
+zmk_ble_mgmt_split_reconnect_adv_param(const struct bt_le_adv_param *param,
+                                       struct bt_le_adv_param *buf) {
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    // Advertising of the central is for hosts, not for the split link
+    return param;
+#else
+    if (!fast_reconnect || !param ||
+        !(param->options & BT_LE_ADV_OPT_CONNECTABLE)) {
+        return param;
+    }
+
+    // High duty directed advertising has no interval to tune
+    if (param->peer && !(param->options & BT_LE_ADV_OPT_DIR_MODE_LOW_DUTY)) {
+        return param;
+    }
+
+    *buf              = *param;
+    buf->interval_min = FAST_ADV_INT_MIN;
+    buf->interval_max = FAST_ADV_INT_MAX;
+    return buf;
+#endif
+}
+
+/**
+ * Settings callback for loading the fast reconnect mode
+ */
+static int split_reconnect_settings_set(const char *name, size_t len,
+                                        settings_read_cb read_cb,
+                                        void *cb_arg) {
+    if (zmk_ble_mgmt_settings_deferred()) {
+        return 0;
+    }
+
+    uint32_t begin = zmk_ble_mgmt_boot_profile_begin();
+    uint8_t value;
+    if (len != sizeof(value)) {
+        LOG_WRN("Invalid fast reconnect setting size: %zu", len);
+        return 0;
+    }
+
+    if (read_cb(cb_arg, &value, sizeof(value)) >= 0) {
+        fast_reconnect = value != 0;
+    }
+    zmk_ble_mgmt_boot_profile_record_done(begin);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(ble_mgmt_fast_reconnect,
+                               "ble_mgmt/fast_reconnect", NULL,
+                               split_reconnect_settings_set, NULL, NULL);
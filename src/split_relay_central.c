@@ -0,0 +1,317 @@
+/**
+ * BLE Management Feature - Management relay, central side
+ *
+ * Reaches the relay service of each split peripheral over the split link so
+ * a single Studio connection to the central can query and manage every
+ * half. The relay characteristic is discovered on first use and cached per
+ * slot until the peripheral disconnects. Operations are synchronous and
+ * serialized; they are issued from the Studio RPC thread and from ZMK's low
+ * priority work queue, which reads the status of each peripheral once after
+ * it connects. The last status read is kept per slot so GetSplitInfo can
+ * report it without waiting on the split link.
+ */
+
+#include <string.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
+#include <zmk/ble_management/split_peripherals.h>
+#include <zmk/ble_management/split_relay.h>
+#include <zmk/workqueue.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define RELAY_TIMEOUT K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RELAY_TIMEOUT_MS)
+
+// Give ZMK's own discovery and subscriptions on a new link a head start
+#define STATUS_READ_DELAY K_SECONDS(2)
+
+static struct bt_uuid_128 relay_char_uuid =
+    BT_UUID_INIT_128(ZMK_BLE_MGMT_SPLIT_RELAY_CHAR_UUID);
+
+// Relay characteristic value handle per slot, valid while conn is connected
+static struct {
+    struct bt_conn *conn;
+    uint16_t handle;
+} handles[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+
+static K_MUTEX_DEFINE(relay_mutex);
+static K_SEM_DEFINE(relay_done, 0, 1);
+
+// Set while the stack owns params; an operation that timed out keeps it set
+// until its callback finally runs or the link drops
+static bool op_pending;
+static struct bt_conn *op_conn;
+
+// Result of the pending operation, filled in by the GATT callbacks
+static int relay_err;
+static uint16_t found_handle;
+static struct zmk_ble_mgmt_split_relay_status read_status;
+
+// Last status read per slot, dropped when its link goes down
+static struct {
+    struct bt_conn *conn;
+    struct zmk_ble_mgmt_split_relay_status status;
+    int64_t read_at;
+} last_status[ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT];
+static struct k_spinlock last_status_lock;
+
+static union {
+    struct bt_gatt_discover_params discover;
+    struct bt_gatt_read_params read;
+    struct bt_gatt_write_params write;
+} params;
+
+static uint8_t discover_cb(struct bt_conn *conn,
+                           const struct bt_gatt_attr *attr,
+                           struct bt_gatt_discover_params *discover) {
+    op_pending = false;
+    if (!attr) {
+        relay_err = -ENOENT;
+    } else {
+        const struct bt_gatt_chrc *chrc = attr->user_data;
+        found_handle                    = chrc->value_handle;
+        relay_err                       = 0;
+    }
+    k_sem_give(&relay_done);
+    return BT_GATT_ITER_STOP;
+}
+
+static uint8_t read_cb(struct bt_conn *conn, uint8_t err,
+                       struct bt_gatt_read_params *read, const void *data,
+                       uint16_t length) {
+    op_pending = false;
+    if (err) {
+        relay_err = -EIO;
+    } else if (!data || length < 2) {
+        // Version and flags are always present
+        relay_err = -EBADMSG;
+    } else {
+        // Older peripherals may send a shorter status; missing fields stay 0
+        memset(&read_status, 0, sizeof(read_status));
+        memcpy(&read_status, data, MIN(length, sizeof(read_status)));
+        relay_err = 0;
+    }
+    k_sem_give(&relay_done);
+    return BT_GATT_ITER_STOP;
+}
+
+static void write_cb(struct bt_conn *conn, uint8_t err,
+                     struct bt_gatt_write_params *write) {
+    op_pending = false;
+    relay_err  = err ? -EIO : 0;
+    k_sem_give(&relay_done);
+}
+
+/**
+ * Wait for the callback of an operation issued with the given result.
+ * Must be called with relay_mutex held.
+ */
+static int wait_done(int rc) {
+    if (rc < 0) {
+        op_pending = false;
+        return rc;
+    }
+    if (k_sem_take(&relay_done, RELAY_TIMEOUT) < 0) {
+        return -ETIMEDOUT;
+    }
+    return relay_err;
+}
+
+/**
+ * Find the relay characteristic on a slot's connection.
+ * Must be called with relay_mutex held.
+ */
+static int resolve_handle(uint8_t slot, struct bt_conn *conn,
+                          uint16_t *handle) {
+    if (op_pending) {
+        return -EBUSY;
+    }
+    if (handles[slot].conn == conn && handles[slot].handle != 0) {
+        *handle = handles[slot].handle;
+        return 0;
+    }
+
+    params.discover = (struct bt_gatt_discover_params){
+        .uuid         = &relay_char_uuid.uuid,
+        .func         = discover_cb,
+        .start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE,
+        .end_handle   = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+        .type         = BT_GATT_DISCOVER_CHARACTERISTIC,
+    };
+    k_sem_reset(&relay_done);
+    op_pending = true;
+    op_conn    = conn;
+    int rc     = wait_done(bt_gatt_discover(conn, &params.discover));
+    if (rc < 0) {
+        return rc;
+    }
+
+    handles[slot].conn   = conn;
+    handles[slot].handle = found_handle;
+    *handle              = found_handle;
+    return 0;
+}
+
+int zmk_ble_mgmt_split_relay_get_status(
+    uint8_t slot, struct zmk_ble_mgmt_split_relay_status *status) {
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT || !status) {
+        return -EINVAL;
+    }
+
+    struct bt_conn *conn = zmk_ble_mgmt_split_peripheral_conn(slot);
+    if (!conn) {
+        return -ENOTCONN;
+    }
+
+    k_mutex_lock(&relay_mutex, K_FOREVER);
+    uint16_t handle;
+    int rc = resolve_handle(slot, conn, &handle);
+    if (rc == 0) {
+        params.read = (struct bt_gatt_read_params){
+            .func          = read_cb,
+            .handle_count  = 1,
+            .single.handle = handle,
+            .single.offset = 0,
+        };
+        k_sem_reset(&relay_done);
+        op_pending = true;
+        op_conn    = conn;
+        rc         = wait_done(bt_gatt_read(conn, &params.read));
+        if (rc == 0) {
+            *status = read_status;
+        }
+    }
+    k_mutex_unlock(&relay_mutex);
+
+    if (rc == 0) {
+        K_SPINLOCK(&last_status_lock) {
+            last_status[slot].conn    = conn;
+            last_status[slot].status  = *status;
+            last_status[slot].read_at = k_uptime_get();
+        }
+    }
+
+    bt_conn_unref(conn);
+    return rc;
+}
+
+int zmk_ble_mgmt_split_relay_get_last_status(
+    uint8_t slot, struct zmk_ble_mgmt_split_relay_status *status) {
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT || !status) {
+        return -EINVAL;
+    }
+
+    int rc = -ENOENT;
+    K_SPINLOCK(&last_status_lock) {
+        if (last_status[slot].conn) {
+            *status = last_status[slot].status;
+            status->uptime_s +=
+                (k_uptime_get() - last_status[slot].read_at) / MSEC_PER_SEC;
+            rc = 0;
+        }
+    }
+    return rc;
+}
+
+/**
+ * Write a one byte command to the relay characteristic of a slot.
+ */
+static int write_op(uint8_t slot, uint8_t op) {
+    if (slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT) {
+        return -EINVAL;
+    }
+
+    struct bt_conn *conn = zmk_ble_mgmt_split_peripheral_conn(slot);
+    if (!conn) {
+        return -ENOTCONN;
+    }
+
+    // The stack holds on to the data until the write callback ran
+    static uint8_t op_buf;
+
+    k_mutex_lock(&relay_mutex, K_FOREVER);
+    uint16_t handle;
+    int rc = resolve_handle(slot, conn, &handle);
+    if (rc == 0) {
+        op_buf       = op;
+        params.write = (struct bt_gatt_write_params){
+            .func   = write_cb,
+            .handle = handle,
+            .offset = 0,
+            .data   = &op_buf,
+            .length = sizeof(op_buf),
+        };
+        k_sem_reset(&relay_done);
+        op_pending = true;
+        op_conn    = conn;
+        rc         = wait_done(bt_gatt_write(conn, &params.write));
+    }
+    k_mutex_unlock(&relay_mutex);
+
+    bt_conn_unref(conn);
+    return rc;
+}
+
+int zmk_ble_mgmt_split_relay_forget_bond(uint8_t slot) {
+    return write_op(slot, ZMK_BLE_MGMT_SPLIT_RELAY_OP_FORGET_BOND);
+}
+
+int zmk_ble_mgmt_split_relay_set_fast_reconnect(uint8_t slot, bool enabled) {
+    return write_op(slot, enabled
+                              ? ZMK_BLE_MGMT_SPLIT_RELAY_OP_FAST_RECONNECT_ON
+                              : ZMK_BLE_MGMT_SPLIT_RELAY_OP_FAST_RECONNECT_OFF);
+}
+
+static void status_work_handler(struct k_work *work) {
+    for (uint8_t i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+        struct zmk_ble_mgmt_split_relay_status status;
+        bool known = zmk_ble_mgmt_split_relay_get_last_status(i, &status) == 0;
+        if (known) {
+            continue;
+        }
+
+        int rc = zmk_ble_mgmt_split_relay_get_status(i, &status);
+        if (rc < 0 && rc != -ENOTCONN) {
+            LOG_DBG("Failed to read status of peripheral %d: %d", i, rc);
+        }
+    }
+}
+
+static K_WORK_DELAYABLE_DEFINE(status_work, status_work_handler);
+
+static void split_relay_connected(struct bt_conn *conn, uint8_t err) {
+    struct bt_conn_info info;
+    if (!err && bt_conn_get_info(conn, &info) == 0 &&
+        info.role == BT_CONN_ROLE_CENTRAL) {
+        k_work_reschedule_for_queue(zmk_workqueue_lowprio_work_q(),
+                                    &status_work, STATUS_READ_DELAY);
+    }
+}
+
+static void split_relay_disconnected(struct bt_conn *conn, uint8_t reason) {
+    // Pending requests on the link are dropped with it
+    if (op_conn == conn) {
+        op_pending = false;
+        op_conn    = NULL;
+    }
+    for (int i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+        if (handles[i].conn == conn) {
+            handles[i].conn   = NULL;
+            handles[i].handle = 0;
+        }
+    }
+    K_SPINLOCK(&last_status_lock) {
+        for (int i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+            if (last_status[i].conn == conn) {
+                last_status[i].conn = NULL;
+            }
+        }
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_split_relay_conn_cb) = {
+    .connected    = split_relay_connected,
+    .disconnected = split_relay_disconnected,
+};
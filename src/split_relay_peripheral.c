@@ -0,0 +1,99 @@
+/**
+ * BLE Management Feature - Management relay, peripheral side
+ *
+ * Studio only talks to the central, so peripherals expose a small GATT
+ * service of their own next to ZMK's split service. Reading the relay
+ * characteristic returns the peripheral's bond and link status; writing an
+ * opcode runs a management command on the peripheral.
+ */
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/split_relay.h>
+#include <zmk/split/bluetooth/peripheral.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+#include <zmk/ble_management/split_reconnect.h>
+#endif
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Lets the write response reach the central before the bond is dropped
+#define FORGET_DELAY K_MSEC(100)
+
+static struct bt_uuid_128 relay_service_uuid =
+    BT_UUID_INIT_128(ZMK_BLE_MGMT_SPLIT_RELAY_SERVICE_UUID);
+static struct bt_uuid_128 relay_char_uuid =
+    BT_UUID_INIT_128(ZMK_BLE_MGMT_SPLIT_RELAY_CHAR_UUID);
+
+static void forget_work_handler(struct k_work *work) {
+    LOG_INF("Forgetting central bond on relay request");
+    zmk_ble_clear_all_bonds();
+}
+
+static K_WORK_DELAYABLE_DEFINE(forget_work, forget_work_handler);
+
+static ssize_t relay_read(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+                          void *buf, uint16_t len, uint16_t offset) {
+    struct zmk_ble_mgmt_split_relay_status status = {
+        .version  = ZMK_BLE_MGMT_SPLIT_RELAY_VERSION,
+        .uptime_s = k_uptime_get() / MSEC_PER_SEC,
+    };
+
+    if (zmk_split_bt_peripheral_is_bonded()) {
+        status.flags |= ZMK_BLE_MGMT_SPLIT_RELAY_BONDED;
+    }
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+    if (zmk_ble_mgmt_split_reconnect_get_fast()) {
+        status.flags |= ZMK_BLE_MGMT_SPLIT_RELAY_FAST_RECONNECT;
+    }
+#endif
+
+    struct bt_conn_info info;
+    if (bt_conn_get_info(conn, &info) == 0) {
+        status.interval = info.le.interval;
+        status.latency  = info.le.latency;
+        status.timeout  = info.le.timeout;
+    }
+
+    return bt_gatt_attr_read(conn, attr, buf, len, offset, &status,
+                             sizeof(status));
+}
+
+static ssize_t relay_write(struct bt_conn *conn,
+                           const struct bt_gatt_attr *attr, const void *buf,
+                           uint16_t len, uint16_t offset, uint8_t flags) {
+    if (offset != 0 || len != 1) {
+        return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+    }
+
+    uint8_t op = *(const uint8_t *)buf;
+    switch (op) {
+        case ZMK_BLE_MGMT_SPLIT_RELAY_OP_FORGET_BOND:
+            k_work_reschedule(&forget_work, FORGET_DELAY);
+            break;
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+        case ZMK_BLE_MGMT_SPLIT_RELAY_OP_FAST_RECONNECT_OFF:
+        case ZMK_BLE_MGMT_SPLIT_RELAY_OP_FAST_RECONNECT_ON:
+            if (zmk_ble_mgmt_split_reconnect_set_fast(
+                    op == ZMK_BLE_MGMT_SPLIT_RELAY_OP_FAST_RECONNECT_ON) < 0) {
+                return BT_GATT_ERR(BT_ATT_ERR_UNLIKELY);
+            }
+            break;
+#endif
+        default:
+            return BT_GATT_ERR(BT_ATT_ERR_NOT_SUPPORTED);
+    }
+    return len;
+}
+
+BT_GATT_SERVICE_DEFINE(
+    ble_mgmt_split_relay, BT_GATT_PRIMARY_SERVICE(&relay_service_uuid),
+    BT_GATT_CHARACTERISTIC(&relay_char_uuid.uuid,
+                           BT_GATT_CHRC_READ | BT_GATT_CHRC_WRITE,
+                           BT_GATT_PERM_READ_ENCRYPT |
+                               BT_GATT_PERM_WRITE_ENCRYPT,
+                           relay_read, relay_write, NULL), );
@@ -4,24 +4,100 @@
  * This file implements BLE management functionality for ZMK Studio.
  * It provides APIs to:
  * - View and manage BLE profiles
- * - Set custom names for profiles (tied to BLE address)
+ * - Set custom names for profiles (tied to BLE address), also ahead of
+ *   pairing for open profiles
  * - Switch active profiles
  * - Unpair profiles
  * - Manage split keyboard connections
  * - Set and get output priority (USB or BLE)
+ * - Tune the activity-adaptive connection interval scheduler
+ * - Read HID report delivery statistics
+ * - Read Bluetooth stack buffer utilization
+ * - Read BLE/USB link-loss failover statistics
+ * - Tune per-profile supervision timeouts
+ * - Read connection parameter update outcomes
+ * - Read wake-to-first-report latency
+ * - Read boot milestones and settings load cost
+ * - Read settings write volume and flash wear estimate
+ * - Tune split peripheral link parameters
+ * - Query and manage split peripherals through the central
+ * - Read split reconnect timing and toggle fast reconnect
+ * - Run factory provisioning cycles and read their step timings
+ * - Import bonds generated off the keyboard
+ * - Read the metrics registry
  */
 
 #include <pb_decode.h>
 #include <pb_encode.h>
+#include <stdlib.h>
 #include <zephyr/bluetooth/addr.h>
 #include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
 #include <zephyr/init.h>
+#include <zephyr/kernel.h>
 #include <zephyr/settings/settings.h>
 #include <zmk/ble.h>
 #include <zmk/ble_management/ble_management.pb.h>
+#include <zmk/ble_management/boot_profile.h>
+#include <zmk/ble_management/lazy_settings.h>
+#include <zmk/ble_management/metrics.h>
+#include <zmk/ble_management/settings_wear.h>
+#include <zmk/ble_management/tracing.h>
 #include <zmk/endpoints.h>
 #include <zmk/studio/custom.h>
 
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER)
+#include <zmk/ble_management/conn_scheduler.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_REPORT_STATS)
+#include <zmk/ble_management/report_stats.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_BUF_MONITOR)
+#include <zmk/ble_management/buf_monitor.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_FAILOVER)
+#include <zmk/ble_management/failover.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SUPERVISION)
+#include <zmk/ble_management/supervision.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PARAM_UPDATE)
+#include <zmk/ble_management/param_update.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_WAKE_LATENCY)
+#include <zmk/ble_management/wake_latency.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_PERIPHERALS)
+#include <zmk/ble_management/split_peripherals.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_LINK)
+#include <zmk/ble_management/split_link.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RELAY)
+#include <zmk/ble_management/split_relay.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+#include <zmk/ble_management/split_reconnect.h>
+#endif
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING)
+#include <zmk/ble_management/provisioning.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_BOND_IMPORT)
+#include <zmk/ble_management/bond_import.h>
+#include <zmk/studio/core.h>
+#endif
+
 #if IS_ENABLED(CONFIG_ZMK_SPLIT_BLE)
 #if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_PERIPHERAL)
 #include <zmk/split/bluetooth/peripheral.h>
@@ -47,6 +123,15 @@ static struct profile_name_entry
     profile_names[1];  // Dummy array when BLE is disabled
 #endif
 
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+// Names set for open profiles, bound to the host that bonds to the profile
+static char pending_names[ZMK_BLE_PROFILE_COUNT][sizeof(profile_names[0].name)];
+#endif
+
+// Guards profile_names and pending_names, which are bound from the system
+// work queue as well as changed by RPCs
+static K_MUTEX_DEFINE(profile_names_lock);
+
 /**
  * Metadata for the custom subsystem.
  */
@@ -65,6 +150,13 @@ ZMK_RPC_CUSTOM_SUBSYSTEM(cormoran_ble, &ble_management_meta,
 ZMK_RPC_CUSTOM_SUBSYSTEM_RESPONSE_BUFFER(cormoran_ble,
                                          zmk_ble_management_Response);
 
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_rpc_requests,
+                                   "rpc_requests");
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(ble_mgmt_metric_rpc_errors, "rpc_errors");
+ZMK_BLE_MGMT_METRIC_HISTOGRAM_DEFINE(ble_mgmt_metric_rpc_time_us,
+                                     "rpc_time_us", 100, 250, 500, 1000,
+                                     2500, 5000, 10000, UINT32_MAX);
+
 // Forward declarations
 static int handle_get_profiles_request(
     const zmk_ble_management_GetProfilesRequest *req,
@@ -90,6 +182,207 @@ static int handle_set_output_priority_request(
 static int handle_get_output_priority_request(
     const zmk_ble_management_GetOutputPriorityRequest *req,
     zmk_ble_management_Response *resp);
+static int handle_get_conn_scheduler_request(
+    const zmk_ble_management_GetConnSchedulerRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_set_conn_scheduler_request(
+    const zmk_ble_management_SetConnSchedulerRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_report_stats_request(
+    const zmk_ble_management_GetReportStatsRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_buffer_usage_request(
+    const zmk_ble_management_GetBufferUsageRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_failover_stats_request(
+    const zmk_ble_management_GetFailoverStatsRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_supervision_request(
+    const zmk_ble_management_GetSupervisionRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_set_supervision_request(
+    const zmk_ble_management_SetSupervisionRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_param_update_stats_request(
+    const zmk_ble_management_GetParamUpdateStatsRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_wake_latency_request(
+    const zmk_ble_management_GetWakeLatencyRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_boot_profile_request(
+    const zmk_ble_management_GetBootProfileRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_settings_wear_request(
+    const zmk_ble_management_GetSettingsWearRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_split_link_request(
+    const zmk_ble_management_GetSplitLinkRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_set_split_link_request(
+    const zmk_ble_management_SetSplitLinkRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_peripheral_status_request(
+    const zmk_ble_management_GetPeripheralStatusRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_forget_peripheral_bond_request(
+    const zmk_ble_management_ForgetPeripheralBondRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_split_reconnect_request(
+    const zmk_ble_management_GetSplitReconnectRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_set_split_reconnect_request(
+    const zmk_ble_management_SetSplitReconnectRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_start_provisioning_request(
+    const zmk_ble_management_StartProvisioningRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_stop_provisioning_request(
+    const zmk_ble_management_StopProvisioningRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_provisioning_request(
+    const zmk_ble_management_GetProvisioningRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_import_bond_request(
+    const zmk_ble_management_ImportBondRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_metrics_schema_request(
+    const zmk_ble_management_GetMetricsSchemaRequest *req,
+    zmk_ble_management_Response *resp);
+static int handle_get_metrics_request(
+    const zmk_ble_management_GetMetricsRequest *req,
+    zmk_ble_management_Response *resp);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+/**
+ * Names are keyed by the bare address: the settings key does not carry the
+ * address type, so entries loaded from settings always come back as public.
+ */
+static bool profile_name_addr_eq(const bt_addr_le_t *a, const bt_addr_le_t *b) {
+    return bt_addr_eq(&a->a, &b->a);
+}
+
+static void profile_name_key(const bt_addr_le_t *addr, char *key,
+                             size_t size) {
+    char addr_str[BT_ADDR_STR_LEN];
+    bt_addr_to_str(&addr->a, addr_str, sizeof(addr_str));
+    snprintf(key, size, "ble_mgmt/name/%s", addr_str);
+}
+
+/**
+ * Address bonded to a profile, or NULL if the profile is open
+ */
+static const bt_addr_le_t *profile_bonded_address(uint8_t index) {
+    if (zmk_ble_profile_is_open(index)) {
+        return NULL;
+    }
+    return zmk_ble_profile_address(index);
+}
+
+static bool profile_name_addr_bonded(const bt_addr_le_t *addr) {
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        const bt_addr_le_t *bonded = profile_bonded_address(i);
+        if (bonded && profile_name_addr_eq(bonded, addr)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Drop a cached entry and its persisted name
+ */
+static void clear_profile_name_slot(int slot) {
+    char key[64];
+    profile_name_key(&profile_names[slot].addr, key, sizeof(key));
+    int rc = zmk_ble_mgmt_settings_delete(key);
+    if (rc < 0) {
+        LOG_WRN("Failed to delete %s: %d", key, rc);
+    }
+
+    bt_addr_le_copy(&profile_names[slot].addr, BT_ADDR_LE_NONE);
+    profile_names[slot].name[0] = '\0';
+}
+
+/**
+ * Names and pending names stored; they share one record per profile
+ */
+static int profile_name_records(void) {
+    int records = 0;
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        records += !bt_addr_le_eq(&profile_names[i].addr, BT_ADDR_LE_NONE);
+        records += pending_names[i][0] != '\0';
+    }
+    return records;
+}
+
+/**
+ * Bonds cleared outside of this handler (e.g. &bt BT_CLR) leave their names
+ * behind; drop one of those.
+ *
+ * Returns the freed cache slot, or -ENOENT if every name is in use.
+ */
+static int reclaim_stale_profile_name(void) {
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        if (!bt_addr_le_eq(&profile_names[i].addr, BT_ADDR_LE_NONE) &&
+            !profile_name_addr_bonded(&profile_names[i].addr)) {
+            clear_profile_name_slot(i);
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+static void pending_name_key(uint8_t index, char *key, size_t size) {
+    snprintf(key, size, "ble_mgmt/pending/%d", index);
+}
+
+/**
+ * Keep a name for an open profile until a host bonds to it. An empty name
+ * drops it.
+ */
+static int save_pending_name(uint8_t index, const char *name) {
+    char key[32];
+    pending_name_key(index, key, sizeof(key));
+
+    if (name[0] == '\0') {
+        int rc = zmk_ble_mgmt_settings_delete(key);
+        if (rc == 0) {
+            pending_names[index][0] = '\0';
+        }
+        return rc;
+    }
+
+    if (pending_names[index][0] == '\0' &&
+        profile_name_records() >= ZMK_BLE_PROFILE_COUNT) {
+        reclaim_stale_profile_name();
+    }
+
+    char pending[sizeof(pending_names[index])];
+    strncpy(pending, name, sizeof(pending) - 1);
+    pending[sizeof(pending) - 1] = '\0';
+
+    int rc = zmk_ble_mgmt_settings_save(key, pending, strlen(pending) + 1);
+    if (rc < 0) {
+        return rc;
+    }
+    strcpy(pending_names[index], pending);
+    return 0;
+}
+
+static void clear_pending_name(uint8_t index) {
+    if (pending_names[index][0] == '\0') {
+        return;
+    }
+
+    char key[32];
+    pending_name_key(index, key, sizeof(key));
+    int rc = zmk_ble_mgmt_settings_delete(key);
+    if (rc < 0) {
+        LOG_WRN("Failed to delete %s: %d", key, rc);
+    }
+    pending_names[index][0] = '\0';
+}
+#endif
 
 /**
  * Get profile name from cache based on BLE address
@@ -101,7 +394,7 @@ static const char *get_profile_name(const bt_addr_le_t *addr) {
     }
 
     for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
-        if (bt_addr_le_eq(&profile_names[i].addr, addr)) {
+        if (profile_name_addr_eq(&profile_names[i].addr, addr)) {
             return profile_names[i].name;
         }
     }
@@ -119,10 +412,12 @@ static int save_profile_name(const bt_addr_le_t *addr, const char *name) {
     }
 
     // Find existing entry or empty slot
-    int slot = -1;
+    int slot   = -1;
+    bool found = false;
     for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
-        if (bt_addr_le_eq(&profile_names[i].addr, addr)) {
-            slot = i;
+        if (profile_name_addr_eq(&profile_names[i].addr, addr)) {
+            slot  = i;
+            found = true;
             break;
         }
         if (slot == -1 &&
@@ -131,35 +426,96 @@ static int save_profile_name(const bt_addr_le_t *addr, const char *name) {
         }
     }
 
+    // Make room when the cache is full or pending names take the rest of
+    // the records
+    if (!found && (slot == -1 || profile_name_records() >=
+                                     ZMK_BLE_PROFILE_COUNT)) {
+        int stale = reclaim_stale_profile_name();
+        if (stale >= 0) {
+            slot = stale;
+        }
+    }
+
     if (slot == -1) {
         LOG_WRN("No slot available for profile name");
         return -ENOMEM;
     }
 
+    // Save to settings first so a refused write leaves the cache as is
+    char setting_name[64];
+    profile_name_key(addr, setting_name, sizeof(setting_name));
+
+    int rc = zmk_ble_mgmt_settings_save(setting_name, name, strlen(name) + 1);
+    if (rc < 0) {
+        return rc;
+    }
+
     // Update cache
     bt_addr_le_copy(&profile_names[slot].addr, addr);
     strncpy(profile_names[slot].name, name,
             sizeof(profile_names[slot].name) - 1);
     profile_names[slot].name[sizeof(profile_names[slot].name) - 1] = '\0';
-
-    // Save to settings
-    char setting_name[64];
-    char addr_str[BT_ADDR_STR_LEN];
-    bt_addr_to_str(&addr->a, addr_str, sizeof(addr_str));
-    snprintf(setting_name, sizeof(setting_name), "ble_mgmt/name/%s", addr_str);
-
-    return settings_save_one(setting_name, name, strlen(name) + 1);
+    return 0;
 #else
     return -ENOTSUP;
 #endif
 }
 
 /**
- * Settings callback for loading profile names
+ * Bind the pending names of profiles that have been bonded since they were
+ * set. Names that fail to save stay pending and are retried on the next
+ * bond or boot.
  */
-static int profile_names_settings_set(const char *name, size_t len,
-                                      settings_read_cb read_cb, void *cb_arg) {
+static void bind_pending_names(void) {
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    k_mutex_lock(&profile_names_lock, K_FOREVER);
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        const bt_addr_le_t *addr = profile_bonded_address(i);
+        if (!addr || pending_names[i][0] == '\0') {
+            continue;
+        }
+
+        int rc = save_profile_name(addr, pending_names[i]);
+        if (rc < 0) {
+            LOG_WRN("Failed to bind pending name of profile %d: %d", i, rc);
+            continue;
+        }
+        LOG_DBG("Bound pending name of profile %d: %s", i, pending_names[i]);
+        clear_pending_name(i);
+    }
+    k_mutex_unlock(&profile_names_lock);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+static void pending_names_work_handler(struct k_work *work) {
+    bind_pending_names();
+}
+
+static K_WORK_DEFINE(pending_names_work, pending_names_work_handler);
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE) && IS_ENABLED(CONFIG_BT_SMP)
+static void pending_names_pairing_complete(struct bt_conn *conn, bool bonded) {
+    // ZMK assigns the bond to the profile in its own callback, so look at
+    // the profiles once every callback has run
+    if (bonded) {
+        k_work_submit(&pending_names_work);
+    }
+}
+
+static struct bt_conn_auth_info_cb pending_names_auth_info_cb = {
+    .pairing_complete = pending_names_pairing_complete,
+};
+#endif
+
 #if IS_ENABLED(CONFIG_ZMK_BLE)
+/**
+ * Load one ble_mgmt/name or ble_mgmt/pending record; records that cannot be
+ * placed are skipped
+ */
+static void load_profile_name(const char *name, settings_read_cb read_cb,
+                              void *cb_arg) {
     const char *next;
     int rc;
 
@@ -173,13 +529,13 @@ static int profile_names_settings_set(const char *name, size_t len,
         if (bt_addr_le_from_str(addr_str, "public", &addr) != 0 &&
             bt_addr_le_from_str(addr_str, "random", &addr) != 0) {
             LOG_WRN("Failed to parse address: %s", addr_str);
-            return 0;
+            return;
         }
 
         // Find or allocate slot
         int slot = -1;
         for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
-            if (bt_addr_le_eq(&profile_names[i].addr, &addr)) {
+            if (profile_name_addr_eq(&profile_names[i].addr, &addr)) {
                 slot = i;
                 break;
             }
@@ -191,7 +547,7 @@ static int profile_names_settings_set(const char *name, size_t len,
 
         if (slot == -1) {
             LOG_WRN("No slot for loading profile name");
-            return 0;
+            return;
         }
 
         bt_addr_le_copy(&profile_names[slot].addr, &addr);
@@ -203,14 +559,60 @@ static int profile_names_settings_set(const char *name, size_t len,
             LOG_DBG("Loaded profile name for %s: %s", addr_str,
                     profile_names[slot].name);
         }
+    } else if (settings_name_steq(name, "pending", &next) && next) {
+        char *end;
+        unsigned long index = strtoul(next, &end, 10);
+        if (end == next || *end != '\0' || index >= ZMK_BLE_PROFILE_COUNT) {
+            LOG_WRN("Unknown pending profile name: %s", next);
+            return;
+        }
+
+        rc = read_cb(cb_arg, pending_names[index],
+                     sizeof(pending_names[index]));
+        if (rc >= 0) {
+            pending_names[index][sizeof(pending_names[index]) - 1] = '\0';
+        }
+    }
+}
+#endif
+
+/**
+ * Settings callback for loading profile names
+ */
+static int profile_names_settings_set(const char *name, size_t len,
+                                      settings_read_cb read_cb, void *cb_arg) {
+    if (zmk_ble_mgmt_settings_deferred()) {
+        return 0;
     }
+
+    // Every record is timed, including the ones that are skipped
+    uint32_t begin = zmk_ble_mgmt_boot_profile_begin();
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    load_profile_name(name, read_cb, cb_arg);
 #endif
+    zmk_ble_mgmt_boot_profile_record_done(begin);
+    return 0;
+}
 
+/**
+ * Settings callback invoked once the ble_mgmt subtree has been loaded
+ */
+static int profile_names_settings_commit(void) {
+    if (!zmk_ble_mgmt_settings_deferred()) {
+        zmk_ble_mgmt_boot_profile_mark(ZMK_BLE_MGMT_BOOT_SETTINGS_COMMIT);
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+        // Bonds made before the names were loaded. Binding saves settings
+        // under profile_names_lock, so it must not run here with the
+        // settings lock held.
+        k_work_submit(&pending_names_work);
+#endif
+    }
     return 0;
 }
 
 SETTINGS_STATIC_HANDLER_DEFINE(ble_mgmt, "ble_mgmt", NULL,
-                               profile_names_settings_set, NULL, NULL);
+                               profile_names_settings_set,
+                               profile_names_settings_commit, NULL);
 
 /**
  * Main request handler for the custom RPC subsystem.
@@ -222,13 +624,26 @@ static bool ble_management_rpc_handle_request(
                                                           encode_response);
 
     zmk_ble_management_Request req = zmk_ble_management_Request_init_zero;
+    uint32_t start = k_cycle_get_32();
+
+    ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_rpc_requests);
+
+    // Management data may not have been loaded yet when loading is deferred
+    zmk_ble_mgmt_settings_ensure_loaded();
 
     // Decode the incoming request
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_RPC_DECODE_IN,
+                       raw_request->payload.size, 0);
     pb_istream_t req_stream = pb_istream_from_buffer(raw_request->payload.bytes,
                                                      raw_request->payload.size);
-    if (!pb_decode(&req_stream, zmk_ble_management_Request_fields, &req)) {
+    bool decoded =
+        pb_decode(&req_stream, zmk_ble_management_Request_fields, &req);
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_RPC_DECODE_OUT,
+                       req.which_request_type, decoded);
+    if (!decoded) {
         LOG_WRN("Failed to decode ble_management request: %s",
                 PB_GET_ERROR(&req_stream));
+        ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_rpc_errors);
         zmk_ble_management_ErrorResponse err =
             zmk_ble_management_ErrorResponse_init_zero;
         snprintf(err.message, sizeof(err.message), "Failed to decode request");
@@ -238,6 +653,8 @@ static bool ble_management_rpc_handle_request(
     }
 
     int rc = 0;
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_RPC_CALL_IN, req.which_request_type,
+                       0);
     switch (req.which_request_type) {
         case zmk_ble_management_Request_get_profiles_tag:
             rc = handle_get_profiles_request(&req.request_type.get_profiles,
@@ -271,10 +688,104 @@ static bool ble_management_rpc_handle_request(
             rc = handle_get_output_priority_request(
                 &req.request_type.get_output_priority, resp);
             break;
+        case zmk_ble_management_Request_get_conn_scheduler_tag:
+            rc = handle_get_conn_scheduler_request(
+                &req.request_type.get_conn_scheduler, resp);
+            break;
+        case zmk_ble_management_Request_set_conn_scheduler_tag:
+            rc = handle_set_conn_scheduler_request(
+                &req.request_type.set_conn_scheduler, resp);
+            break;
+        case zmk_ble_management_Request_get_report_stats_tag:
+            rc = handle_get_report_stats_request(
+                &req.request_type.get_report_stats, resp);
+            break;
+        case zmk_ble_management_Request_get_buffer_usage_tag:
+            rc = handle_get_buffer_usage_request(
+                &req.request_type.get_buffer_usage, resp);
+            break;
+        case zmk_ble_management_Request_get_failover_stats_tag:
+            rc = handle_get_failover_stats_request(
+                &req.request_type.get_failover_stats, resp);
+            break;
+        case zmk_ble_management_Request_get_supervision_tag:
+            rc = handle_get_supervision_request(
+                &req.request_type.get_supervision, resp);
+            break;
+        case zmk_ble_management_Request_set_supervision_tag:
+            rc = handle_set_supervision_request(
+                &req.request_type.set_supervision, resp);
+            break;
+        case zmk_ble_management_Request_get_param_update_stats_tag:
+            rc = handle_get_param_update_stats_request(
+                &req.request_type.get_param_update_stats, resp);
+            break;
+        case zmk_ble_management_Request_get_wake_latency_tag:
+            rc = handle_get_wake_latency_request(
+                &req.request_type.get_wake_latency, resp);
+            break;
+        case zmk_ble_management_Request_get_boot_profile_tag:
+            rc = handle_get_boot_profile_request(
+                &req.request_type.get_boot_profile, resp);
+            break;
+        case zmk_ble_management_Request_get_settings_wear_tag:
+            rc = handle_get_settings_wear_request(
+                &req.request_type.get_settings_wear, resp);
+            break;
+        case zmk_ble_management_Request_get_split_link_tag:
+            rc = handle_get_split_link_request(&req.request_type.get_split_link,
+                                               resp);
+            break;
+        case zmk_ble_management_Request_set_split_link_tag:
+            rc = handle_set_split_link_request(&req.request_type.set_split_link,
+                                               resp);
+            break;
+        case zmk_ble_management_Request_get_peripheral_status_tag:
+            rc = handle_get_peripheral_status_request(
+                &req.request_type.get_peripheral_status, resp);
+            break;
+        case zmk_ble_management_Request_forget_peripheral_bond_tag:
+            rc = handle_forget_peripheral_bond_request(
+                &req.request_type.forget_peripheral_bond, resp);
+            break;
+        case zmk_ble_management_Request_get_split_reconnect_tag:
+            rc = handle_get_split_reconnect_request(
+                &req.request_type.get_split_reconnect, resp);
+            break;
+        case zmk_ble_management_Request_set_split_reconnect_tag:
+            rc = handle_set_split_reconnect_request(
+                &req.request_type.set_split_reconnect, resp);
+            break;
+        case zmk_ble_management_Request_start_provisioning_tag:
+            rc = handle_start_provisioning_request(
+                &req.request_type.start_provisioning, resp);
+            break;
+        case zmk_ble_management_Request_stop_provisioning_tag:
+            rc = handle_stop_provisioning_request(
+                &req.request_type.stop_provisioning, resp);
+            break;
+        case zmk_ble_management_Request_get_provisioning_tag:
+            rc = handle_get_provisioning_request(
+                &req.request_type.get_provisioning, resp);
+            break;
+        case zmk_ble_management_Request_import_bond_tag:
+            rc = handle_import_bond_request(&req.request_type.import_bond,
+                                            resp);
+            break;
+        case zmk_ble_management_Request_get_metrics_schema_tag:
+            rc = handle_get_metrics_schema_request(
+                &req.request_type.get_metrics_schema, resp);
+            break;
+        case zmk_ble_management_Request_get_metrics_tag:
+            rc = handle_get_metrics_request(&req.request_type.get_metrics,
+                                            resp);
+            break;
         default:
             LOG_WRN("Unsupported request type: %d", req.which_request_type);
             rc = -ENOTSUP;
     }
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_RPC_CALL_OUT, req.which_request_type,
+                       rc);
 
     if (rc != 0) {
         zmk_ble_management_ErrorResponse err =
@@ -283,7 +794,11 @@ static bool ble_management_rpc_handle_request(
                  "Failed to process request: %d", rc);
         resp->which_response_type = zmk_ble_management_Response_error_tag;
         resp->response_type.error = err;
+        ZMK_BLE_MGMT_METRIC_INC(ble_mgmt_metric_rpc_errors);
     }
+
+    ZMK_BLE_MGMT_METRIC_OBSERVE(ble_mgmt_metric_rpc_time_us,
+                                k_cyc_to_us_floor32(k_cycle_get_32() - start));
     return true;
 }
 
@@ -303,6 +818,7 @@ static int handle_get_profiles_request(
 
     int active = zmk_ble_active_profile_index();
 
+    k_mutex_lock(&profile_names_lock, K_FOREVER);
     for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
         zmk_ble_management_ProfileInfo *profile = &result.profiles[i];
         profile->index                          = i;
@@ -311,8 +827,8 @@ static int handle_get_profiles_request(
         profile->is_active    = (i == active);
 
         // Get BLE address
-        bt_addr_le_t *addr = zmk_ble_profile_address(i);
-        if (addr && !bt_addr_le_eq(addr, BT_ADDR_LE_NONE)) {
+        const bt_addr_le_t *addr = profile_bonded_address(i);
+        if (addr) {
             char addr_str[BT_ADDR_LE_STR_LEN];
             bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
             strncpy(profile->address, addr_str, sizeof(profile->address) - 1);
@@ -324,8 +840,11 @@ static int handle_get_profiles_request(
                 strncpy(profile->name, name, sizeof(profile->name) - 1);
                 profile->name[sizeof(profile->name) - 1] = '\0';
             }
+        } else {
+            strcpy(profile->name, pending_names[i]);
         }
     }
+    k_mutex_unlock(&profile_names_lock);
 
     result.profiles_count = ZMK_BLE_PROFILE_COUNT;
 #else
@@ -354,14 +873,16 @@ static int handle_set_profile_name_request(
         LOG_WRN("Invalid profile index: %d", req->index);
         result.success = false;
     } else {
-        bt_addr_le_t *addr = zmk_ble_profile_address(req->index);
-        if (addr && !bt_addr_le_eq(addr, BT_ADDR_LE_NONE)) {
-            int rc         = save_profile_name(addr, req->name);
-            result.success = (rc == 0);
-        } else {
-            LOG_WRN("Profile %d has no address", req->index);
-            result.success = false;
+        k_mutex_lock(&profile_names_lock, K_FOREVER);
+        const bt_addr_le_t *addr = profile_bonded_address(req->index);
+        // Open profiles keep the name until a host bonds to them
+        int rc = addr ? save_profile_name(addr, req->name)
+                      : save_pending_name(req->index, req->name);
+        k_mutex_unlock(&profile_names_lock);
+        if (rc < 0) {
+            LOG_WRN("Failed to save name of profile %d: %d", req->index, rc);
         }
+        result.success = (rc == 0);
     }
 #else
     result.success = false;
@@ -417,17 +938,19 @@ static int handle_unpair_profile_request(
         LOG_WRN("Invalid profile index: %d", req->index);
         result.success = false;
     } else {
-        // Clear profile name from cache if it exists
-        bt_addr_le_t *addr = zmk_ble_profile_address(req->index);
-        if (addr && !bt_addr_le_eq(addr, BT_ADDR_LE_NONE)) {
+        // Clear the profile name from cache and settings if it exists
+        k_mutex_lock(&profile_names_lock, K_FOREVER);
+        const bt_addr_le_t *addr = profile_bonded_address(req->index);
+        if (addr) {
             for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
-                if (bt_addr_le_eq(&profile_names[i].addr, addr)) {
-                    bt_addr_le_copy(&profile_names[i].addr, BT_ADDR_LE_NONE);
-                    profile_names[i].name[0] = '\0';
+                if (profile_name_addr_eq(&profile_names[i].addr, addr)) {
+                    clear_profile_name_slot(i);
                     break;
                 }
             }
         }
+        clear_pending_name(req->index);
+        k_mutex_unlock(&profile_names_lock);
         int active = zmk_ble_active_profile_index();
         int rc     = zmk_ble_prof_select(req->index);
         if (rc == 0) {
@@ -462,12 +985,49 @@ static int handle_get_split_info_request(
 #if IS_ENABLED(CONFIG_ZMK_SPLIT_BLE)
     info->is_split = true;
 #if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
-    info->is_central = true;
-    // For central, check if peripheral is connected
-    // Note: ZMK doesn't expose a direct API for this, so we'll set it to false
-    // for now
+    info->is_central           = true;
     info->peripheral_connected = false;
     info->central_bonded       = false;
+
+    BUILD_ASSERT(ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT <=
+                     ARRAY_SIZE(result.peripherals),
+                 "Too many split peripherals for GetSplitInfoResponse");
+    for (uint8_t i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+        struct zmk_ble_mgmt_split_peripheral peripheral;
+        if (zmk_ble_mgmt_split_peripheral_get(i, &peripheral) < 0) {
+            continue;
+        }
+
+        zmk_ble_management_SplitPeripheralInfo *entry =
+            &result.peripherals[result.peripherals_count++];
+        entry->slot                   = i;
+        entry->connected              = peripheral.connected;
+        entry->bonded                 = peripheral.bonded;
+        entry->interval               = peripheral.interval;
+        entry->latency                = peripheral.latency;
+        entry->timeout                = peripheral.timeout;
+        entry->battery_known          = peripheral.battery_known;
+        entry->battery_level          = peripheral.battery_level;
+        entry->reconnects             = peripheral.reconnects;
+        entry->disconnects            = peripheral.disconnects;
+        entry->last_disconnect_reason = peripheral.last_disconnect_reason;
+        entry->last_disconnect_age_s  = peripheral.last_disconnect_age_s;
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RELAY)
+        struct zmk_ble_mgmt_split_relay_status status;
+        if (peripheral.connected &&
+            zmk_ble_mgmt_split_relay_get_last_status(i, &status) == 0) {
+            entry->uptime_known = true;
+            entry->uptime_s     = status.uptime_s;
+        }
+#endif
+        if (peripheral.bonded) {
+            char addr_str[BT_ADDR_LE_STR_LEN];
+            bt_addr_le_to_str(&peripheral.addr, addr_str, sizeof(addr_str));
+            strncpy(entry->address, addr_str, sizeof(entry->address) - 1);
+            entry->address[sizeof(entry->address) - 1] = '\0';
+        }
+        info->peripheral_connected |= peripheral.connected;
+    }
 #elif IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_PERIPHERAL)
     info->is_central           = false;
     info->peripheral_connected = false;
@@ -497,8 +1057,22 @@ static int handle_forget_split_bond_request(
         zmk_ble_management_ForgetSplitBondResponse_init_zero;
 
 #if IS_ENABLED(CONFIG_ZMK_SPLIT_BLE)
-    // Clear all bonds to reset split connection
+    // Clear all bonds to reset split connection. Host bonds go with it, so
+    // do their names.
     zmk_ble_clear_all_bonds();
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_PERIPHERALS)
+    zmk_ble_mgmt_split_peripherals_invalidate();
+#endif
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    k_mutex_lock(&profile_names_lock, K_FOREVER);
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        if (!bt_addr_le_eq(&profile_names[i].addr, BT_ADDR_LE_NONE)) {
+            clear_profile_name_slot(i);
+        }
+        clear_pending_name(i);
+    }
+    k_mutex_unlock(&profile_names_lock);
+#endif
     result.success = true;
 #else
     LOG_WRN("Split BLE not enabled");
@@ -587,18 +1161,1035 @@ static int handle_get_output_priority_request(
 }
 
 /**
- * Initialize profile names on boot
+ * Handle GetConnSchedulerRequest
  */
-static int profile_names_init(void) {
-#if IS_ENABLED(CONFIG_ZMK_BLE)
-    // Initialize all entries to empty
-    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
-        bt_addr_le_copy(&profile_names[i].addr, BT_ADDR_LE_NONE);
-        profile_names[i].name[0] = '\0';
+static int handle_get_conn_scheduler_request(
+    const zmk_ble_management_GetConnSchedulerRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetConnSchedulerRequest: index=%d", req->index);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER)
+    zmk_ble_management_GetConnSchedulerResponse result =
+        zmk_ble_management_GetConnSchedulerResponse_init_zero;
+
+    if (req->index >= ZMK_BLE_PROFILE_COUNT) {
+        LOG_WRN("Invalid profile index: %d", req->index);
+        return -EINVAL;
+    }
+
+    struct zmk_ble_mgmt_conn_sched_config config;
+    struct zmk_ble_mgmt_conn_sched_stats stats;
+    int rc = zmk_ble_mgmt_conn_sched_get_config(req->index, &config);
+    if (rc == 0) {
+        rc = zmk_ble_mgmt_conn_sched_get_stats(req->index, &stats);
+    }
+    if (rc != 0) {
+        return rc;
     }
+
+    result.has_config             = true;
+    result.config.idle_timeout_ms = config.idle_timeout_ms;
+    result.config.fast_interval   = config.fast_interval;
+    result.config.slow_interval   = config.slow_interval;
+    result.config.slow_latency    = config.slow_latency;
+
+    result.has_stats           = true;
+    result.stats.fast_ms       = stats.fast_ms;
+    result.stats.slow_ms       = stats.slow_ms;
+    result.stats.fast_requests = stats.fast_requests;
+    result.stats.slow_requests = stats.slow_requests;
+    result.stats.fast_active   = stats.fast_active;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_conn_scheduler_tag;
+    resp->response_type.get_conn_scheduler = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle SetConnSchedulerRequest
+ */
+static int handle_set_conn_scheduler_request(
+    const zmk_ble_management_SetConnSchedulerRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("SetConnSchedulerRequest: index=%d", req->index);
+
+    zmk_ble_management_SetConnSchedulerResponse result =
+        zmk_ble_management_SetConnSchedulerResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER)
+    if (req->index >= ZMK_BLE_PROFILE_COUNT || !req->has_config ||
+        req->config.fast_interval > UINT16_MAX ||
+        req->config.slow_interval > UINT16_MAX ||
+        req->config.slow_latency > UINT16_MAX) {
+        LOG_WRN("Invalid connection scheduler request for profile %d",
+                req->index);
+        result.success = false;
+    } else {
+        struct zmk_ble_mgmt_conn_sched_config config = {
+            .idle_timeout_ms = req->config.idle_timeout_ms,
+            .fast_interval   = req->config.fast_interval,
+            .slow_interval   = req->config.slow_interval,
+            .slow_latency    = req->config.slow_latency,
+        };
+        int rc = zmk_ble_mgmt_conn_sched_set_config(req->index, &config);
+        result.success = (rc == 0);
+    }
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type =
+        zmk_ble_management_Response_set_conn_scheduler_tag;
+    resp->response_type.set_conn_scheduler = result;
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_REPORT_STATS)
+static void copy_report_stats(zmk_ble_management_ReportStats *dst,
+                              const struct zmk_ble_mgmt_report_stats *src) {
+    dst->sent          = src->sent;
+    dst->failed        = src->failed;
+    dst->notify_failed = src->notify_failed;
+    dst->no_buffer     = src->no_buffer;
+}
+#endif
+
+/**
+ * Handle GetReportStatsRequest
+ */
+static int handle_get_report_stats_request(
+    const zmk_ble_management_GetReportStatsRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetReportStatsRequest: reset=%d", req->reset);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_REPORT_STATS)
+    zmk_ble_management_GetReportStatsResponse result =
+        zmk_ble_management_GetReportStatsResponse_init_zero;
+    struct zmk_ble_mgmt_report_stats stats;
+
+    zmk_ble_mgmt_report_stats_get_usb(&stats);
+    result.has_usb = true;
+    copy_report_stats(&result.usb, &stats);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        zmk_ble_management_ProfileReportStats *entry = &result.ble[i];
+        zmk_ble_mgmt_report_stats_get_ble(i, &stats);
+        entry->index     = i;
+        entry->has_stats = true;
+        copy_report_stats(&entry->stats, &stats);
+    }
+    result.ble_count = ZMK_BLE_PROFILE_COUNT;
+#endif
+
+    if (req->reset) {
+        zmk_ble_mgmt_report_stats_reset();
+    }
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_report_stats_tag;
+    resp->response_type.get_report_stats = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle GetBufferUsageRequest
+ */
+static int handle_get_buffer_usage_request(
+    const zmk_ble_management_GetBufferUsageRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetBufferUsageRequest: reset=%d", req->reset);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_BUF_MONITOR)
+    zmk_ble_management_GetBufferUsageResponse result =
+        zmk_ble_management_GetBufferUsageResponse_init_zero;
+
+    zmk_ble_mgmt_buf_monitor_sample();
+    size_t count = MIN(zmk_ble_mgmt_buf_monitor_count(),
+                       ARRAY_SIZE(result.pools));
+    for (size_t i = 0; i < count; i++) {
+        struct zmk_ble_mgmt_buf_pool_usage usage;
+        if (zmk_ble_mgmt_buf_monitor_get(i, &usage) != 0) {
+            break;
+        }
+
+        zmk_ble_management_BufPoolUsage *pool = &result.pools[i];
+        if (usage.name) {
+            strncpy(pool->name, usage.name, sizeof(pool->name) - 1);
+            pool->name[sizeof(pool->name) - 1] = '\0';
+        }
+        pool->size     = usage.size;
+        pool->used     = usage.used;
+        pool->max_used = usage.max_used;
+        result.pools_count++;
+    }
+    result.sample_interval_ms =
+        CONFIG_ZMK_BLE_MANAGEMENT_BUF_MONITOR_INTERVAL_MS;
+
+    if (req->reset) {
+        zmk_ble_mgmt_buf_monitor_reset();
+    }
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_buffer_usage_tag;
+    resp->response_type.get_buffer_usage = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle GetFailoverStatsRequest
+ */
+static int handle_get_failover_stats_request(
+    const zmk_ble_management_GetFailoverStatsRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetFailoverStatsRequest");
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_FAILOVER)
+    zmk_ble_management_GetFailoverStatsResponse result =
+        zmk_ble_management_GetFailoverStatsResponse_init_zero;
+    struct zmk_ble_mgmt_failover_stats stats;
+
+    int rc = zmk_ble_mgmt_failover_get_stats(&stats);
+    if (rc != 0) {
+        return rc;
+    }
+
+    result.has_stats          = true;
+    result.stats.failovers    = stats.failovers;
+    result.stats.failbacks    = stats.failbacks;
+    result.stats.gaps         = stats.gaps;
+    result.stats.last_gap_ms  = stats.last_gap_ms;
+    result.stats.max_gap_ms   = stats.max_gap_ms;
+    result.stats.total_gap_ms = stats.total_gap_ms;
+
+    result.active = zmk_endpoints_selected().transport == ZMK_TRANSPORT_USB
+                        ? zmk_ble_management_OutputPriority_OUTPUT_PRIORITY_USB
+                        : zmk_ble_management_OutputPriority_OUTPUT_PRIORITY_BLE;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_failover_stats_tag;
+    resp->response_type.get_failover_stats = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle GetSupervisionRequest
+ */
+static int handle_get_supervision_request(
+    const zmk_ble_management_GetSupervisionRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetSupervisionRequest: index=%d", req->index);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SUPERVISION)
+    zmk_ble_management_GetSupervisionResponse result =
+        zmk_ble_management_GetSupervisionResponse_init_zero;
+    struct zmk_ble_mgmt_supervision_stats stats;
+
+    if (req->index >= ZMK_BLE_PROFILE_COUNT) {
+        LOG_WRN("Invalid profile index: %d", req->index);
+        return -EINVAL;
+    }
+
+    int rc = zmk_ble_mgmt_supervision_get_stats(req->index, &stats);
+    if (rc != 0) {
+        return rc;
+    }
+
+    result.timeout             = zmk_ble_mgmt_supervision_get_timeout(req->index);
+    result.current_timeout     = stats.current_timeout;
+    result.timeout_disconnects = stats.timeout_disconnects;
+    result.last_detect_ms      = stats.last_detect_ms;
+    result.max_detect_ms       = stats.max_detect_ms;
+    result.keys_at_risk        = stats.keys_at_risk;
+
+    resp->which_response_type = zmk_ble_management_Response_get_supervision_tag;
+    resp->response_type.get_supervision = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle SetSupervisionRequest
+ */
+static int handle_set_supervision_request(
+    const zmk_ble_management_SetSupervisionRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("SetSupervisionRequest: index=%d, timeout=%d", req->index,
+            req->timeout);
+
+    zmk_ble_management_SetSupervisionResponse result =
+        zmk_ble_management_SetSupervisionResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SUPERVISION)
+    if (req->index >= ZMK_BLE_PROFILE_COUNT || req->timeout > UINT16_MAX) {
+        LOG_WRN("Invalid supervision request for profile %d", req->index);
+        result.success = false;
+    } else {
+        int rc = zmk_ble_mgmt_supervision_set_timeout(req->index, req->timeout);
+        result.success = (rc == 0);
+    }
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type = zmk_ble_management_Response_set_supervision_tag;
+    resp->response_type.set_supervision = result;
+    return 0;
+}
+
+/**
+ * Handle GetParamUpdateStatsRequest
+ */
+static int handle_get_param_update_stats_request(
+    const zmk_ble_management_GetParamUpdateStatsRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetParamUpdateStatsRequest");
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PARAM_UPDATE)
+    zmk_ble_management_GetParamUpdateStatsResponse result =
+        zmk_ble_management_GetParamUpdateStatsResponse_init_zero;
+
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        struct zmk_ble_mgmt_param_update_stats stats;
+        zmk_ble_mgmt_param_update_get_stats(i, &stats);
+
+        zmk_ble_management_ParamUpdateStats *entry = &result.profiles[i];
+        entry->index         = i;
+        entry->attempts      = stats.attempts;
+        entry->accepted      = stats.accepted;
+        entry->rejected      = stats.rejected;
+        entry->ignored       = stats.ignored;
+        entry->retries       = stats.retries;
+        entry->last_interval = stats.last_interval;
+        entry->last_latency  = stats.last_latency;
+        entry->last_timeout  = stats.last_timeout;
+    }
+    result.profiles_count = ZMK_BLE_PROFILE_COUNT;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_param_update_stats_tag;
+    resp->response_type.get_param_update_stats = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle GetWakeLatencyRequest
+ */
+static int handle_get_wake_latency_request(
+    const zmk_ble_management_GetWakeLatencyRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetWakeLatencyRequest");
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_WAKE_LATENCY)
+    zmk_ble_management_GetWakeLatencyResponse result =
+        zmk_ble_management_GetWakeLatencyResponse_init_zero;
+    struct zmk_ble_mgmt_wake_session session;
+
+    zmk_ble_mgmt_wake_latency_get_last(&session);
+    result.has_last             = true;
+    switch (session.kind) {
+        case ZMK_BLE_MGMT_WAKE_IDLE:
+            result.last.kind = zmk_ble_management_WakeKind_WAKE_KIND_IDLE;
+            break;
+        case ZMK_BLE_MGMT_WAKE_DEEP_SLEEP:
+            result.last.kind =
+                zmk_ble_management_WakeKind_WAKE_KIND_DEEP_SLEEP;
+            break;
+        case ZMK_BLE_MGMT_WAKE_BOOT:
+        default:
+            result.last.kind = zmk_ble_management_WakeKind_WAKE_KIND_BOOT;
+            break;
+    }
+    result.last.adv_start_ms    = session.adv_start_ms;
+    result.last.connected_ms    = session.connected_ms;
+    result.last.secured_ms      = session.secured_ms;
+    result.last.first_report_ms = session.first_report_ms;
+    result.last.profile         = session.profile;
+
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        zmk_ble_management_WakeLatencyHistogram *hist = &result.histograms[i];
+        hist->index = i;
+        zmk_ble_mgmt_wake_latency_get_histogram(i, hist->counts);
+        hist->counts_count = ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS;
+    }
+    result.histograms_count = ZMK_BLE_PROFILE_COUNT;
+
+    memcpy(result.bucket_bounds_ms, zmk_ble_mgmt_wake_latency_bounds,
+           sizeof(zmk_ble_mgmt_wake_latency_bounds));
+    result.bucket_bounds_ms_count = ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_wake_latency_tag;
+    resp->response_type.get_wake_latency = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle GetBootProfileRequest
+ */
+static int handle_get_boot_profile_request(
+    const zmk_ble_management_GetBootProfileRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetBootProfileRequest");
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_BOOT_PROFILE)
+    zmk_ble_management_GetBootProfileResponse result =
+        zmk_ble_management_GetBootProfileResponse_init_zero;
+    struct zmk_ble_mgmt_boot_profile profile;
+
+    zmk_ble_mgmt_boot_profile_get(&profile);
+    result.has_profile = true;
+    result.profile.init_us = profile.milestones_us[ZMK_BLE_MGMT_BOOT_INIT];
+    result.profile.settings_load_start_us =
+        profile.milestones_us[ZMK_BLE_MGMT_BOOT_SETTINGS_LOAD_START];
+    result.profile.settings_first_record_us =
+        profile.milestones_us[ZMK_BLE_MGMT_BOOT_SETTINGS_FIRST_RECORD];
+    result.profile.settings_commit_us =
+        profile.milestones_us[ZMK_BLE_MGMT_BOOT_SETTINGS_COMMIT];
+    result.profile.first_adv_us =
+        profile.milestones_us[ZMK_BLE_MGMT_BOOT_FIRST_ADV];
+    result.profile.first_connect_us =
+        profile.milestones_us[ZMK_BLE_MGMT_BOOT_FIRST_CONNECT];
+    result.profile.init_duration_us = profile.init_us;
+    result.profile.records          = profile.records;
+    result.profile.record_total_us  = profile.record_total_us;
+    result.profile.record_max_us    = profile.record_max_us;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_boot_profile_tag;
+    resp->response_type.get_boot_profile = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle GetSettingsWearRequest
+ */
+static int handle_get_settings_wear_request(
+    const zmk_ble_management_GetSettingsWearRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetSettingsWearRequest");
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR)
+    zmk_ble_management_GetSettingsWearResponse result =
+        zmk_ble_management_GetSettingsWearResponse_init_zero;
+    struct zmk_ble_mgmt_settings_wear wear;
+
+    static const zmk_ble_management_SettingsClass classes[] = {
+        [ZMK_BLE_MGMT_SETTINGS_NAME] =
+            zmk_ble_management_SettingsClass_SETTINGS_CLASS_NAME,
+        [ZMK_BLE_MGMT_SETTINGS_SCHED] =
+            zmk_ble_management_SettingsClass_SETTINGS_CLASS_SCHED,
+        [ZMK_BLE_MGMT_SETTINGS_STO] =
+            zmk_ble_management_SettingsClass_SETTINGS_CLASS_STO,
+        [ZMK_BLE_MGMT_SETTINGS_SPLIT_LINK] =
+            zmk_ble_management_SettingsClass_SETTINGS_CLASS_SPLIT_LINK,
+        [ZMK_BLE_MGMT_SETTINGS_OTHER] =
+            zmk_ble_management_SettingsClass_SETTINGS_CLASS_OTHER,
+    };
+
+    zmk_ble_mgmt_settings_wear_get(&wear);
+    for (int i = 0; i < ZMK_BLE_MGMT_SETTINGS_CLASS_COUNT; i++) {
+        zmk_ble_management_SettingsClassStats *entry = &result.classes[i];
+        entry->key_class    = classes[i];
+        entry->writes       = wear.classes[i].writes;
+        entry->bytes        = wear.classes[i].bytes;
+        entry->rate_limited = wear.classes[i].rate_limited;
+    }
+    result.classes_count        = ZMK_BLE_MGMT_SETTINGS_CLASS_COUNT;
+    result.lifetime_flash_bytes = wear.lifetime_flash_bytes;
+    result.partition_size       = wear.partition_size;
+    result.endurance_cycles =
+        CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR_ENDURANCE_CYCLES;
+    result.remaining_permille = wear.remaining_permille;
+    result.tokens             = wear.tokens;
+    result.rate_burst = CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR_RATE_BURST;
+    result.rate_refill_ms =
+        CONFIG_ZMK_BLE_MANAGEMENT_SETTINGS_WEAR_RATE_REFILL_MS;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_settings_wear_tag;
+    resp->response_type.get_settings_wear = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_LINK)
+static void split_link_params_to_proto(
+    const struct zmk_ble_mgmt_split_link_params *params,
+    zmk_ble_management_SplitLinkParams *out) {
+    out->interval = params->interval;
+    out->latency  = params->latency;
+    out->timeout  = params->timeout;
+    out->phy      = params->phy;
+}
+
+static void split_link_probe_to_proto(
+    const struct zmk_ble_mgmt_split_link_probe *probe,
+    zmk_ble_management_SplitLinkProbe *out) {
+    out->samples = probe->samples;
+    out->min_us  = probe->min_us;
+    out->avg_us  = probe->avg_us;
+    out->max_us  = probe->max_us;
+}
+#endif
+
+/**
+ * Handle GetSplitLinkRequest
+ */
+static int handle_get_split_link_request(
+    const zmk_ble_management_GetSplitLinkRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetSplitLinkRequest: slot=%d", req->slot);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_LINK)
+    zmk_ble_management_GetSplitLinkResponse result =
+        zmk_ble_management_GetSplitLinkResponse_init_zero;
+    struct zmk_ble_mgmt_split_link_state state;
+
+    if (req->slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT) {
+        return -EINVAL;
+    }
+
+    int rc = zmk_ble_mgmt_split_link_get(req->slot, &state);
+    if (rc < 0) {
+        return rc;
+    }
+
+    result.slot       = req->slot;
+    result.configured = state.configured;
+    result.has_params = state.configured;
+    split_link_params_to_proto(&state.params, &result.params);
+    result.connected   = state.connected;
+    result.has_current = state.connected;
+    split_link_params_to_proto(&state.current, &result.current);
+    result.has_before = true;
+    split_link_probe_to_proto(&state.before, &result.before);
+    result.has_after = true;
+    split_link_probe_to_proto(&state.after, &result.after);
+
+    resp->which_response_type = zmk_ble_management_Response_get_split_link_tag;
+    resp->response_type.get_split_link = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle SetSplitLinkRequest
+ */
+static int handle_set_split_link_request(
+    const zmk_ble_management_SetSplitLinkRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("SetSplitLinkRequest: slot=%d", req->slot);
+
+    zmk_ble_management_SetSplitLinkResponse result =
+        zmk_ble_management_SetSplitLinkResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_LINK)
+    const zmk_ble_management_SplitLinkParams *p = &req->params;
+    if (req->slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT ||
+        (req->has_params &&
+         (p->interval > UINT16_MAX || p->latency > UINT16_MAX ||
+          p->timeout > UINT16_MAX || p->phy > UINT8_MAX))) {
+        LOG_WRN("Invalid split link request for slot %d", req->slot);
+        result.success = false;
+    } else if (req->has_params) {
+        struct zmk_ble_mgmt_split_link_params params = {
+            .interval = p->interval,
+            .latency  = p->latency,
+            .timeout  = p->timeout,
+            .phy      = p->phy,
+        };
+        int rc = zmk_ble_mgmt_split_link_set(req->slot, &params);
+        result.success = (rc == 0);
+    } else {
+        int rc = zmk_ble_mgmt_split_link_set(req->slot, NULL);
+        result.success = (rc == 0);
+    }
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type = zmk_ble_management_Response_set_split_link_tag;
+    resp->response_type.set_split_link = result;
+    return 0;
+}
+
+/**
+ * Handle GetPeripheralStatusRequest
+ */
+static int handle_get_peripheral_status_request(
+    const zmk_ble_management_GetPeripheralStatusRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetPeripheralStatusRequest: slot=%d", req->slot);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RELAY) &&                       \
+    IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    zmk_ble_management_GetPeripheralStatusResponse result =
+        zmk_ble_management_GetPeripheralStatusResponse_init_zero;
+    struct zmk_ble_mgmt_split_relay_status status;
+
+    if (req->slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT) {
+        return -EINVAL;
+    }
+
+    int rc = zmk_ble_mgmt_split_relay_get_status(req->slot, &status);
+    if (rc < 0) {
+        return rc;
+    }
+
+    result.slot            = req->slot;
+    result.has_status      = true;
+    result.status.version  = status.version;
+    result.status.bonded   = status.flags & ZMK_BLE_MGMT_SPLIT_RELAY_BONDED;
+    result.status.interval = status.interval;
+    result.status.latency  = status.latency;
+    result.status.timeout  = status.timeout;
+    result.status.uptime_s = status.uptime_s;
+    result.status.fast_reconnect =
+        status.flags & ZMK_BLE_MGMT_SPLIT_RELAY_FAST_RECONNECT;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_peripheral_status_tag;
+    resp->response_type.get_peripheral_status = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle ForgetPeripheralBondRequest
+ */
+static int handle_forget_peripheral_bond_request(
+    const zmk_ble_management_ForgetPeripheralBondRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("ForgetPeripheralBondRequest: slot=%d", req->slot);
+
+    zmk_ble_management_ForgetPeripheralBondResponse result =
+        zmk_ble_management_ForgetPeripheralBondResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RELAY) &&                       \
+    IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    if (req->slot >= ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT) {
+        result.success = false;
+    } else {
+        int rc = zmk_ble_mgmt_split_relay_forget_bond(req->slot);
+        if (rc < 0) {
+            LOG_WRN("Failed to relay forget bond to slot %d: %d", req->slot,
+                    rc);
+        }
+        result.success = (rc == 0);
+    }
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type =
+        zmk_ble_management_Response_forget_peripheral_bond_tag;
+    resp->response_type.forget_peripheral_bond = result;
+    return 0;
+}
+
+/**
+ * Handle GetSplitReconnectRequest
+ */
+static int handle_get_split_reconnect_request(
+    const zmk_ble_management_GetSplitReconnectRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetSplitReconnectRequest");
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+    zmk_ble_management_GetSplitReconnectResponse result =
+        zmk_ble_management_GetSplitReconnectResponse_init_zero;
+    struct zmk_ble_mgmt_split_reconnect_stats stats;
+
+    zmk_ble_mgmt_split_reconnect_get_stats(&stats);
+    result.fast_reconnect  = zmk_ble_mgmt_split_reconnect_get_fast();
+    result.boot_connect_ms = stats.boot_connect_ms;
+    result.reconnects      = stats.reconnects;
+    result.last_ms         = stats.last_ms;
+    result.max_ms          = stats.max_ms;
+
+    memcpy(result.counts, stats.counts, sizeof(stats.counts));
+    result.counts_count = ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS;
+    memcpy(result.bucket_bounds_ms, zmk_ble_mgmt_split_reconnect_bounds,
+           sizeof(zmk_ble_mgmt_split_reconnect_bounds));
+    result.bucket_bounds_ms_count = ZMK_BLE_MGMT_SPLIT_RECONNECT_BUCKETS;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_split_reconnect_tag;
+    resp->response_type.get_split_reconnect = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle SetSplitReconnectRequest
+ */
+static int handle_set_split_reconnect_request(
+    const zmk_ble_management_SetSplitReconnectRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("SetSplitReconnectRequest: fast=%d peripherals=%d",
+            req->fast_reconnect, req->include_peripherals);
+
+    zmk_ble_management_SetSplitReconnectResponse result =
+        zmk_ble_management_SetSplitReconnectResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RECONNECT)
+    int rc = zmk_ble_mgmt_split_reconnect_set_fast(req->fast_reconnect);
+    if (rc < 0) {
+        LOG_WRN("Failed to save fast reconnect mode: %d", rc);
+    }
+    result.success = (rc == 0);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_SPLIT_RELAY) &&                       \
+    IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    // Disconnected peripherals keep their mode; the count tells the caller
+    if (req->include_peripherals) {
+        for (uint8_t i = 0; i < ZMK_BLE_MGMT_SPLIT_PERIPHERAL_COUNT; i++) {
+            rc = zmk_ble_mgmt_split_relay_set_fast_reconnect(
+                i, req->fast_reconnect);
+            if (rc == 0) {
+                result.peripherals_updated++;
+            } else if (rc != -ENOTCONN) {
+                LOG_WRN("Failed to relay fast reconnect to slot %d: %d", i,
+                        rc);
+            }
+        }
+    }
+#endif
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type =
+        zmk_ble_management_Response_set_split_reconnect_tag;
+    resp->response_type.set_split_reconnect = result;
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING)
+static zmk_ble_management_ProvisioningStep
+provisioning_step_to_proto(enum zmk_ble_mgmt_provisioning_step step) {
+    switch (step) {
+        case ZMK_BLE_MGMT_PROVISIONING_CONNECT:
+            return zmk_ble_management_ProvisioningStep_PROVISIONING_STEP_CONNECT;
+        case ZMK_BLE_MGMT_PROVISIONING_PAIR:
+            return zmk_ble_management_ProvisioningStep_PROVISIONING_STEP_PAIR;
+        case ZMK_BLE_MGMT_PROVISIONING_VERIFY:
+            return zmk_ble_management_ProvisioningStep_PROVISIONING_STEP_VERIFY;
+        case ZMK_BLE_MGMT_PROVISIONING_UNPAIR:
+            return zmk_ble_management_ProvisioningStep_PROVISIONING_STEP_UNPAIR;
+        default:
+            return zmk_ble_management_ProvisioningStep_PROVISIONING_STEP_NONE;
+    }
+}
+#endif
+
+/**
+ * Handle StartProvisioningRequest
+ */
+static int handle_start_provisioning_request(
+    const zmk_ble_management_StartProvisioningRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("StartProvisioningRequest: profile=%d cycles=%d", req->profile,
+            req->cycles);
+
+    zmk_ble_management_StartProvisioningResponse result =
+        zmk_ble_management_StartProvisioningResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING)
+    int rc = req->profile < ZMK_BLE_PROFILE_COUNT
+                 ? zmk_ble_mgmt_provisioning_start(req->profile, req->cycles)
+                 : -EINVAL;
+    if (rc < 0) {
+        LOG_WRN("Failed to start provisioning: %d", rc);
+    }
+    result.success = (rc == 0);
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type =
+        zmk_ble_management_Response_start_provisioning_tag;
+    resp->response_type.start_provisioning = result;
+    return 0;
+}
+
+/**
+ * Handle StopProvisioningRequest
+ */
+static int handle_stop_provisioning_request(
+    const zmk_ble_management_StopProvisioningRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("StopProvisioningRequest");
+
+    zmk_ble_management_StopProvisioningResponse result =
+        zmk_ble_management_StopProvisioningResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING)
+    result.success = (zmk_ble_mgmt_provisioning_stop() == 0);
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type =
+        zmk_ble_management_Response_stop_provisioning_tag;
+    resp->response_type.stop_provisioning = result;
+    return 0;
+}
+
+/**
+ * Handle GetProvisioningRequest
+ */
+static int handle_get_provisioning_request(
+    const zmk_ble_management_GetProvisioningRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetProvisioningRequest");
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_PROVISIONING)
+    zmk_ble_management_GetProvisioningResponse result =
+        zmk_ble_management_GetProvisioningResponse_init_zero;
+    struct zmk_ble_mgmt_provisioning_status status;
+
+    BUILD_ASSERT(ZMK_BLE_MGMT_PROVISIONING_STEP_COUNT ==
+                     ARRAY_SIZE(result.steps),
+                 "Provisioning steps do not match GetProvisioningResponse");
+
+    zmk_ble_mgmt_provisioning_get_status(&status);
+    result.running          = status.running;
+    result.profile          = status.profile;
+    result.step             = provisioning_step_to_proto(status.step);
+    result.cycles_requested = status.cycles_requested;
+    result.cycles_passed    = status.cycles_passed;
+    result.cycles_failed    = status.cycles_failed;
+    result.last_failed_step =
+        provisioning_step_to_proto(status.last_failed_step);
+    result.last_cycle_ms    = status.last_cycle_ms;
+    result.elapsed_ms       = status.elapsed_ms;
+
+    for (int i = 0; i < ZMK_BLE_MGMT_PROVISIONING_STEP_COUNT; i++) {
+        const struct zmk_ble_mgmt_provisioning_step_stats *stats =
+            &status.steps[i];
+        zmk_ble_management_ProvisioningStepStats *entry = &result.steps[i];
+        entry->step    = provisioning_step_to_proto(i);
+        entry->count   = stats->count;
+        entry->last_ms = stats->last_ms;
+        entry->min_ms  = stats->min_ms;
+        entry->max_ms  = stats->max_ms;
+        entry->mean_ms = stats->count ? stats->total_ms / stats->count : 0;
+    }
+    result.steps_count = ZMK_BLE_MGMT_PROVISIONING_STEP_COUNT;
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_provisioning_tag;
+    resp->response_type.get_provisioning = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle ImportBondRequest
+ */
+static int handle_import_bond_request(
+    const zmk_ble_management_ImportBondRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("ImportBondRequest: index=%d", req->index);
+
+    zmk_ble_management_ImportBondResponse result =
+        zmk_ble_management_ImportBondResponse_init_zero;
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_BOND_IMPORT)
+    struct zmk_ble_mgmt_bond bond = {.authenticated = req->authenticated};
+    int rc                        = 0;
+
+    // Anyone with USB access could otherwise plant a bond for their host
+    if (zmk_studio_core_get_lock_state() !=
+        ZMK_STUDIO_CORE_LOCK_STATE_UNLOCKED) {
+        rc = -EACCES;
+    } else if (req->index >= ZMK_BLE_PROFILE_COUNT ||
+               req->ltk.size != sizeof(bond.ltk) ||
+               (req->irk.size != 0 && req->irk.size != sizeof(bond.irk))) {
+        rc = -EINVAL;
+    } else {
+        rc = bt_addr_le_from_str(req->address,
+                                 req->random_address ? "random" : "public",
+                                 &bond.addr);
+    }
+
+    if (rc == 0) {
+        memcpy(bond.ltk, req->ltk.bytes, sizeof(bond.ltk));
+        if (req->irk.size) {
+            memcpy(bond.irk, req->irk.bytes, sizeof(bond.irk));
+            bond.has_irk = true;
+        }
+        rc = zmk_ble_mgmt_bond_import(req->index, &bond);
+    }
+    if (rc == 0 && req->name[0]) {
+        k_mutex_lock(&profile_names_lock, K_FOREVER);
+        clear_pending_name(req->index);
+        rc = save_profile_name(&bond.addr, req->name);
+        k_mutex_unlock(&profile_names_lock);
+    } else if (rc == 0) {
+        bind_pending_names();
+    }
+
+    if (rc < 0) {
+        LOG_WRN("Failed to import bond into profile %d: %d", req->index, rc);
+    }
+    result.success = (rc == 0);
+#else
+    result.success = false;
+#endif
+
+    resp->which_response_type = zmk_ble_management_Response_import_bond_tag;
+    resp->response_type.import_bond = result;
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_METRICS)
+static zmk_ble_management_MetricType
+metric_type_to_proto(enum zmk_ble_mgmt_metric_type type) {
+    switch (type) {
+        case ZMK_BLE_MGMT_METRIC_GAUGE:
+            return zmk_ble_management_MetricType_METRIC_TYPE_GAUGE;
+        case ZMK_BLE_MGMT_METRIC_HISTOGRAM:
+            return zmk_ble_management_MetricType_METRIC_TYPE_HISTOGRAM;
+        case ZMK_BLE_MGMT_METRIC_COUNTER:
+        default:
+            return zmk_ble_management_MetricType_METRIC_TYPE_COUNTER;
+    }
+}
+#endif
+
+/**
+ * Handle GetMetricsSchemaRequest
+ */
+static int handle_get_metrics_schema_request(
+    const zmk_ble_management_GetMetricsSchemaRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetMetricsSchemaRequest: first=%d", req->first);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_METRICS)
+    zmk_ble_management_GetMetricsSchemaResponse result =
+        zmk_ble_management_GetMetricsSchemaResponse_init_zero;
+
+    BUILD_ASSERT(ZMK_BLE_MGMT_METRIC_MAX_BUCKETS <=
+                     ARRAY_SIZE(result.metrics[0].bucket_bounds),
+                 "Metric buckets do not fit MetricInfo");
+    BUILD_ASSERT(ZMK_BLE_MGMT_METRIC_NAME_MAX <=
+                     sizeof(result.metrics[0].name),
+                 "Metric names do not fit MetricInfo");
+
+    size_t count     = zmk_ble_mgmt_metrics_count();
+    result.schema_id = zmk_ble_mgmt_metrics_schema_id();
+    result.count     = count;
+    result.first     = req->first;
+
+    for (size_t i = req->first;
+         i < count && result.metrics_count < ARRAY_SIZE(result.metrics); i++) {
+        const struct zmk_ble_mgmt_metric *metric = zmk_ble_mgmt_metrics_get(i);
+        zmk_ble_management_MetricInfo *info =
+            &result.metrics[result.metrics_count++];
+
+        strncpy(info->name, metric->name, sizeof(info->name) - 1);
+        info->type = metric_type_to_proto(metric->type);
+        for (uint8_t b = 0; b < metric->buckets; b++) {
+            info->bucket_bounds[b] = metric->bounds[b];
+        }
+        info->bucket_bounds_count = metric->buckets;
+    }
+
+    resp->which_response_type =
+        zmk_ble_management_Response_get_metrics_schema_tag;
+    resp->response_type.get_metrics_schema = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Handle GetMetricsRequest
+ */
+static int handle_get_metrics_request(
+    const zmk_ble_management_GetMetricsRequest *req,
+    zmk_ble_management_Response *resp) {
+    LOG_DBG("GetMetricsRequest: first=%d", req->first);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_METRICS)
+    zmk_ble_management_GetMetricsResponse result =
+        zmk_ble_management_GetMetricsResponse_init_zero;
+    size_t len;
+
+    BUILD_ASSERT(sizeof(result.values.bytes) >= ZMK_BLE_MGMT_METRIC_MAX_SIZE,
+                 "GetMetricsResponse.values cannot hold the largest metric");
+
+    result.schema_id = zmk_ble_mgmt_metrics_schema_id();
+    result.first     = req->first;
+    result.next      = zmk_ble_mgmt_metrics_dump(
+        req->first, result.values.bytes, sizeof(result.values.bytes), &len);
+    result.values.size = len;
+
+    resp->which_response_type = zmk_ble_management_Response_get_metrics_tag;
+    resp->response_type.get_metrics = result;
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+/**
+ * Initialize profile names on boot
+ */
+static int profile_names_init(void) {
+    uint32_t begin = zmk_ble_mgmt_boot_profile_begin();
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    // Initialize all entries to empty
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        bt_addr_le_copy(&profile_names[i].addr, BT_ADDR_LE_NONE);
+        profile_names[i].name[0] = '\0';
+        pending_names[i][0]      = '\0';
+    }
+#endif
+#if IS_ENABLED(CONFIG_ZMK_BLE) && IS_ENABLED(CONFIG_BT_SMP)
+    bt_conn_auth_info_cb_register(&pending_names_auth_info_cb);
 #endif
 
     LOG_DBG("Profile names initialized");
+    zmk_ble_mgmt_boot_profile_init_done(begin);
     return 0;
 }
 
@@ -0,0 +1,284 @@
+/**
+ * BLE Management Feature - Per-profile supervision timeout tuning
+ *
+ * Applies a per-profile supervision timeout on top of the interval and
+ * latency negotiated by ZMK, so a host that went out of range is detected
+ * sooner. When a link drops on supervision timeout, the time from the last
+ * packet to the disconnect (the timeout in effect) is recorded, along with
+ * whether a key was pressed inside that window and may have been lost.
+ * Timeouts are persisted under "ble_mgmt/sto/<idx>".
+ */
+
+#include <stdlib.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/boot_profile.h>
+#include <zmk/ble_management/conn_scheduler.h>
+#include <zmk/ble_management/lazy_settings.h>
+#include <zmk/ble_management/param_update.h>
+#include <zmk/ble_management/profiles.h>
+#include <zmk/ble_management/settings_wear.h>
+#include <zmk/ble_management/supervision.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Valid supervision timeout range (10 ms units) per the BLE specification
+#define SUPERVISION_TIMEOUT_MIN 10
+#define SUPERVISION_TIMEOUT_MAX 3200
+
+#define APPLY_DELAY K_MSEC(CONFIG_ZMK_BLE_MANAGEMENT_SUPERVISION_APPLY_DELAY_MS)
+
+static uint16_t timeouts[ZMK_BLE_PROFILE_COUNT];
+// The timeout was requested on the current link; a host that answers with
+// another timeout, or never answers, is not asked again until it reconnects
+static bool requested[ZMK_BLE_PROFILE_COUNT];
+static struct zmk_ble_mgmt_supervision_stats stats[ZMK_BLE_PROFILE_COUNT];
+
+static int64_t last_key_at;
+
+static void apply_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(apply_work, apply_work_handler);
+
+/**
+ * Request the configured timeout once on every connected profile that differs
+ */
+static void apply_work_handler(struct k_work *work) {
+    for (uint8_t i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        if (timeouts[i] == 0 || requested[i]) {
+            continue;
+        }
+
+        struct bt_conn *conn = zmk_ble_mgmt_profile_conn(i);
+        if (!conn) {
+            continue;
+        }
+
+        struct bt_conn_info info;
+        if (bt_conn_get_info(conn, &info) == 0 &&
+            info.state == BT_CONN_STATE_CONNECTED &&
+            info.le.timeout != timeouts[i]) {
+            struct bt_le_conn_param param = BT_LE_CONN_PARAM_INIT(
+                info.le.interval, info.le.interval, info.le.latency,
+                timeouts[i]);
+            int rc = zmk_ble_mgmt_param_update_request(conn, &param);
+            if (rc == -EBUSY) {
+                // Another request is outstanding; check again once it is over
+                k_work_reschedule(&apply_work, APPLY_DELAY);
+            } else if (rc < 0 && rc != -EALREADY) {
+                LOG_WRN("Failed to request supervision timeout %d on "
+                        "profile %d: %d",
+                        timeouts[i], i, rc);
+            } else {
+                requested[i] = true;
+            }
+        }
+        bt_conn_unref(conn);
+    }
+}
+
+static int supervision_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *pos =
+        as_zmk_position_state_changed(eh);
+    if (pos && pos->state) {
+        last_key_at = k_uptime_get();
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ble_mgmt_supervision, supervision_listener);
+ZMK_SUBSCRIPTION(ble_mgmt_supervision, zmk_position_state_changed);
+
+static void supervision_connected(struct bt_conn *conn, uint8_t err) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile >= 0) {
+        requested[profile] = false;
+    }
+    if (!err) {
+        // Let ZMK finish its own parameter negotiation first
+        k_work_reschedule(&apply_work, APPLY_DELAY);
+    }
+}
+
+static void supervision_le_param_updated(struct bt_conn *conn,
+                                         uint16_t interval, uint16_t latency,
+                                         uint16_t timeout) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile < 0 || timeouts[profile] == 0 || timeouts[profile] == timeout) {
+        return;
+    }
+
+    if (requested[profile]) {
+        LOG_DBG("Profile %d host keeps supervision timeout %d instead of %d",
+                profile, timeout, timeouts[profile]);
+        return;
+    }
+    // Parameters renegotiated before the timeout was requested
+    k_work_reschedule(&apply_work, APPLY_DELAY);
+}
+
+static void supervision_disconnected(struct bt_conn *conn, uint8_t reason) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (profile < 0) {
+        return;
+    }
+
+    requested[profile] = false;
+    if (reason != BT_HCI_ERR_CONN_TIMEOUT) {
+        return;
+    }
+
+    struct bt_conn_info info;
+    if (bt_conn_get_info(conn, &info) != 0) {
+        return;
+    }
+
+    struct zmk_ble_mgmt_supervision_stats *s = &stats[profile];
+    uint32_t detect_ms = info.le.timeout * 10;
+    s->timeout_disconnects++;
+    s->last_detect_ms = detect_ms;
+    if (detect_ms > s->max_detect_ms) {
+        s->max_detect_ms = detect_ms;
+    }
+    if (last_key_at != 0 && k_uptime_get() - last_key_at < detect_ms) {
+        s->keys_at_risk++;
+    }
+    LOG_DBG("Profile %d supervision timeout after %u ms", profile, detect_ms);
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_supervision_conn_cb) = {
+    .connected        = supervision_connected,
+    .disconnected     = supervision_disconnected,
+    .le_param_updated = supervision_le_param_updated,
+};
+
+uint16_t zmk_ble_mgmt_supervision_get_timeout(uint8_t profile) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT) {
+        return 0;
+    }
+    return timeouts[profile];
+}
+
+/**
+ * Longest (1 + latency) * interval the timeout has to cover: that of the
+ * current link and of the scheduler's slow mode
+ */
+static uint32_t longest_period(uint8_t profile) {
+    uint32_t period = 0;
+
+    struct bt_conn *conn = zmk_ble_mgmt_profile_conn(profile);
+    if (conn) {
+        struct bt_conn_info info;
+        if (bt_conn_get_info(conn, &info) == 0 &&
+            info.state == BT_CONN_STATE_CONNECTED) {
+            period = (1 + info.le.latency) * info.le.interval;
+        }
+        bt_conn_unref(conn);
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_BLE_MANAGEMENT_CONN_SCHEDULER)
+    struct zmk_ble_mgmt_conn_sched_config cfg;
+    if (zmk_ble_mgmt_conn_sched_get_config(profile, &cfg) == 0) {
+        period = MAX(period, (1 + cfg.slow_latency) * cfg.slow_interval);
+    }
+#endif
+    return period;
+}
+
+int zmk_ble_mgmt_supervision_set_timeout(uint8_t profile, uint16_t timeout) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT ||
+        (timeout != 0 && (timeout < SUPERVISION_TIMEOUT_MIN ||
+                          timeout > SUPERVISION_TIMEOUT_MAX))) {
+        return -EINVAL;
+    }
+
+    // Supervision timeout must exceed (1 + latency) * interval * 2
+    uint32_t period = longest_period(profile);
+    if (timeout != 0 && period >= timeout * 4) {
+        LOG_WRN("Supervision timeout %d too short for profile %d", timeout,
+                profile);
+        return -EINVAL;
+    }
+
+    char setting_name[32];
+    snprintf(setting_name, sizeof(setting_name), "ble_mgmt/sto/%d", profile);
+    int rc = timeout == 0 ? zmk_ble_mgmt_settings_delete(setting_name)
+                          : zmk_ble_mgmt_settings_save(setting_name, &timeout,
+                                                       sizeof(timeout));
+    if (rc < 0) {
+        return rc;
+    }
+
+    timeouts[profile]  = timeout;
+    requested[profile] = false;
+    k_work_reschedule(&apply_work, K_NO_WAIT);
+    return 0;
+}
+
+int zmk_ble_mgmt_supervision_get_stats(
+    uint8_t profile, struct zmk_ble_mgmt_supervision_stats *out) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT || !out) {
+        return -EINVAL;
+    }
+
+    *out                 = stats[profile];
+    out->current_timeout = 0;
+
+    struct bt_conn *conn = zmk_ble_mgmt_profile_conn(profile);
+    if (conn) {
+        struct bt_conn_info info;
+        if (bt_conn_get_info(conn, &info) == 0 &&
+            info.state == BT_CONN_STATE_CONNECTED) {
+            out->current_timeout = info.le.timeout;
+        }
+        bt_conn_unref(conn);
+    }
+    return 0;
+}
+
+/**
+ * Settings callback for loading per-profile timeouts
+ */
+static int supervision_settings_set(const char *name, size_t len,
+                                    settings_read_cb read_cb, void *cb_arg) {
+    if (zmk_ble_mgmt_settings_deferred()) {
+        return 0;
+    }
+
+    uint32_t begin = zmk_ble_mgmt_boot_profile_begin();
+    char *end;
+    unsigned long profile = strtoul(name, &end, 10);
+    if (end == name || *end != '\0' || profile >= ZMK_BLE_PROFILE_COUNT ||
+        len != sizeof(uint16_t)) {
+        LOG_WRN("Unknown supervision timeout setting: %s", name);
+        return 0;
+    }
+
+    uint16_t timeout;
+    int rc = read_cb(cb_arg, &timeout, sizeof(timeout));
+    if (rc >= 0 && timeout >= SUPERVISION_TIMEOUT_MIN &&
+        timeout <= SUPERVISION_TIMEOUT_MAX) {
+        timeouts[profile] = timeout;
+    }
+    zmk_ble_mgmt_boot_profile_record_done(begin);
+    return 0;
+}
+
+/**
+ * Settings callback invoked once timeouts are loaded, which may be after
+ * hosts connected when loading is deferred
+ */
+static int supervision_settings_commit(void) {
+    k_work_reschedule(&apply_work, K_NO_WAIT);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(ble_mgmt_sto, "ble_mgmt/sto", NULL,
+                               supervision_settings_set,
+                               supervision_settings_commit, NULL);
@@ -0,0 +1,73 @@
+/**
+ * BLE Management Feature - Trace events for profile, connection and key
+ * activity
+ *
+ * The RPC handler and settings writes trace themselves (see tracing.h);
+ * this file adds the events they interact with: key position changes from
+ * keyscan and, on BLE builds, active profile changes and connection
+ * callbacks from the BT RX thread.
+ */
+
+#include <zmk/ble_management/tracing.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zephyr/bluetooth/conn.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#endif
+
+static int tracing_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *pos =
+        as_zmk_position_state_changed(eh);
+    if (pos) {
+        ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_KEY, pos->position, pos->state);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    const struct zmk_ble_active_profile_changed *profile =
+        as_zmk_ble_active_profile_changed(eh);
+    if (profile) {
+        ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_PROFILE, profile->index, 0);
+    }
+#endif
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ble_mgmt_tracing, tracing_listener);
+ZMK_SUBSCRIPTION(ble_mgmt_tracing, zmk_position_state_changed);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+ZMK_SUBSCRIPTION(ble_mgmt_tracing, zmk_ble_active_profile_changed);
+
+static void tracing_connected(struct bt_conn *conn, uint8_t err) {
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_CONNECTED, bt_conn_index(conn), err);
+}
+
+static void tracing_disconnected(struct bt_conn *conn, uint8_t reason) {
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_DISCONNECTED, bt_conn_index(conn),
+                       reason);
+}
+
+static void tracing_security_changed(struct bt_conn *conn,
+                                     bt_security_t level,
+                                     enum bt_security_err err) {
+    // Level in the low byte, error above it
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_SECURITY, bt_conn_index(conn),
+                       level | (err << 8));
+}
+
+static void tracing_le_param_updated(struct bt_conn *conn, uint16_t interval,
+                                     uint16_t latency, uint16_t timeout) {
+    ZMK_BLE_MGMT_TRACE(ZMK_BLE_MGMT_TRACE_PARAM_UPDATED, bt_conn_index(conn),
+                       interval);
+}
+
+BT_CONN_CB_DEFINE(tracing_conn_callbacks) = {
+    .connected        = tracing_connected,
+    .disconnected     = tracing_disconnected,
+    .security_changed = tracing_security_changed,
+    .le_param_updated = tracing_le_param_updated,
+};
+#endif
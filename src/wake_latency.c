@@ -0,0 +1,173 @@
+/**
+ * BLE Management Feature - Wake-to-first-report latency measurement
+ *
+ * A wake starts at boot or when ZMK reports activity after being idle. From
+ * there, advertising start and the first HID report over BLE (both from
+ * link_hooks.c), connection and security are timestamped, and the
+ * wake-to-first-report time is added to a per-profile histogram and to a
+ * registry histogram over every profile.
+ *
+ * Idle wakes and wakes from deep sleep (a boot whose reset cause is a low
+ * power wake, e.g. leaving System OFF on nRF) are caused by a keypress, so
+ * their first report follows right away. After a cold boot the first report
+ * waits for the user to type, which can be hours later, so that session
+ * ends once the link is encrypted and is kept out of the histogram. Without
+ * CONFIG_HWINFO every boot counts as a cold boot.
+ */
+
+#include <string.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/drivers/hwinfo.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zmk/ble.h>
+#include <zmk/ble_management/metrics.h>
+#include <zmk/ble_management/profiles.h>
+#include <zmk/ble_management/wake_latency.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Shared with the registry histogram, whose bounds must be literals
+#define WAKE_LATENCY_BOUNDS                                                    \
+    10, 25, 50, 100, 250, 500, 1000, 2500, 5000, UINT32_MAX
+
+const uint32_t zmk_ble_mgmt_wake_latency_bounds[] = {WAKE_LATENCY_BOUNDS};
+
+ZMK_BLE_MGMT_METRIC_HISTOGRAM_DEFINE(ble_mgmt_metric_wake_first_report_ms,
+                                     "wake_first_report_ms",
+                                     WAKE_LATENCY_BOUNDS);
+
+BUILD_ASSERT(ARRAY_SIZE(zmk_ble_mgmt_wake_latency_bounds) ==
+             ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS);
+
+static uint32_t histograms[ZMK_BLE_PROFILE_COUNT]
+                          [ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS];
+
+// The wake being measured starts at boot (uptime 0); wake_latency_init
+// tells a wake from deep sleep apart
+static struct zmk_ble_mgmt_wake_session current = {
+    .kind    = ZMK_BLE_MGMT_WAKE_BOOT,
+    .profile = -1,
+};
+static struct zmk_ble_mgmt_wake_session last = {
+    .profile = -1,
+};
+static int64_t wake_at;
+static bool measuring = true;
+
+static uint32_t since_wake(void) {
+    uint32_t elapsed = (uint32_t)(k_uptime_get() - wake_at);
+    // Keep 0 reserved for milestones that were not observed
+    return MAX(elapsed, 1);
+}
+
+static int wake_latency_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev =
+        as_zmk_activity_state_changed(eh);
+    if (ev && ev->state == ZMK_ACTIVITY_ACTIVE) {
+        wake_at   = k_uptime_get();
+        measuring = true;
+        current   = (struct zmk_ble_mgmt_wake_session){
+            .kind    = ZMK_BLE_MGMT_WAKE_IDLE,
+            .profile = -1,
+        };
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ble_mgmt_wake_latency, wake_latency_listener);
+ZMK_SUBSCRIPTION(ble_mgmt_wake_latency, zmk_activity_state_changed);
+
+void zmk_ble_mgmt_wake_latency_adv_started(void) {
+    if (measuring && current.adv_start_ms == 0) {
+        current.adv_start_ms = since_wake();
+    }
+}
+
+static void wake_latency_connected(struct bt_conn *conn, uint8_t err) {
+    if (!err && measuring && current.connected_ms == 0 &&
+        zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn)) >= 0) {
+        current.connected_ms = since_wake();
+    }
+}
+
+static void wake_latency_security_changed(struct bt_conn *conn,
+                                          bt_security_t level,
+                                          enum bt_security_err err) {
+    int profile = zmk_ble_mgmt_profile_index(bt_conn_get_dst(conn));
+    if (err || !measuring || current.secured_ms != 0 || profile < 0) {
+        return;
+    }
+
+    current.secured_ms = since_wake();
+    // Only a cold boot stops here; other wakes go on to the first report
+    if (current.kind == ZMK_BLE_MGMT_WAKE_BOOT) {
+        measuring       = false;
+        current.profile = profile;
+        last            = current;
+        LOG_DBG("Boot link to profile %d encrypted after %u ms", profile,
+                current.secured_ms);
+    }
+}
+
+BT_CONN_CB_DEFINE(ble_mgmt_wake_latency_conn_cb) = {
+    .connected        = wake_latency_connected,
+    .security_changed = wake_latency_security_changed,
+};
+
+void zmk_ble_mgmt_wake_latency_report_sent(uint8_t profile) {
+    if (!measuring || profile >= ZMK_BLE_PROFILE_COUNT) {
+        return;
+    }
+
+    measuring               = false;
+    current.first_report_ms = since_wake();
+    current.profile         = profile;
+    last                    = current;
+
+    for (int i = 0; i < ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS; i++) {
+        if (current.first_report_ms < zmk_ble_mgmt_wake_latency_bounds[i] ||
+            i == ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS - 1) {
+            histograms[profile][i]++;
+            break;
+        }
+    }
+    ZMK_BLE_MGMT_METRIC_OBSERVE(ble_mgmt_metric_wake_first_report_ms,
+                                current.first_report_ms);
+    LOG_DBG("First report on profile %d %u ms after wake", profile,
+            current.first_report_ms);
+}
+
+int zmk_ble_mgmt_wake_latency_get_last(
+    struct zmk_ble_mgmt_wake_session *session) {
+    if (!session) {
+        return -EINVAL;
+    }
+
+    *session = last;
+    return 0;
+}
+
+int zmk_ble_mgmt_wake_latency_get_histogram(
+    uint8_t profile, uint32_t counts[ZMK_BLE_MGMT_WAKE_LATENCY_BUCKETS]) {
+    if (profile >= ZMK_BLE_PROFILE_COUNT || !counts) {
+        return -EINVAL;
+    }
+
+    memcpy(counts, histograms[profile], sizeof(histograms[profile]));
+    return 0;
+}
+
+static int wake_latency_init(void) {
+    uint32_t cause;
+    if (IS_ENABLED(CONFIG_HWINFO) && hwinfo_get_reset_cause(&cause) == 0 &&
+        (cause & RESET_LOW_POWER_WAKE)) {
+        current.kind = ZMK_BLE_MGMT_WAKE_DEEP_SLEEP;
+    }
+    return 0;
+}
+
+SYS_INIT(wake_latency_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
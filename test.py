@@ -1,3 +1,4 @@
+import os
 import platform
 import shutil
 import subprocess
@@ -42,6 +43,55 @@ class WestCommandsTests(unittest.TestCase):
         self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
         self.assertIn("PASS: studio", result.stdout)
 
+    @unittest.skipUnless(platform.system() == "Linux", "native_posix is only supported on Linux")
+    def test_handler(self):
+        build_dir = self.BUILD_DIR / "tests" / "handler"
+        result = run_west(["build", "-p", "-b", "native_posix_64", "-d", str(build_dir), "tests/handler"])
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+
+        result = subprocess.run(
+            [str(build_dir / "zephyr" / "zephyr.exe")],
+            capture_output=True,
+            text=True,
+        )
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("PROJECT EXECUTION SUCCESSFUL", result.stdout)
+
+    @unittest.skipUnless(platform.system() == "Linux", "native_posix is only supported on Linux")
+    def test_settings_bench(self):
+        for backend in ("nvs", "fcb", "fs"):
+            for layout in ("STRING_KEY", "BLOB"):
+                with self.subTest(backend=backend, layout=layout):
+                    build_dir = self.BUILD_DIR / "tests" / "settings_bench" / f"{backend}_{layout.lower()}"
+                    result = run_west(["build", "-p", "-b", "native_posix_64", "-d", str(build_dir),
+                                       "tests/settings_bench", "--", f"-DEXTRA_CONF_FILE={backend}.conf",
+                                       f"-DCONFIG_BENCH_LAYOUT_{layout}=y"])
+                    self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+
+                    result = subprocess.run(
+                        [str(build_dir / "zephyr" / "zephyr.exe")],
+                        capture_output=True,
+                        text=True,
+                        cwd=build_dir,
+                    )
+                    self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+                    self.assertIn("PROJECT EXECUTION SUCCESSFUL", result.stdout)
+                    print("".join(line + "\n" for line in result.stdout.splitlines() if "BENCH " in line), end="")
+
+    @unittest.skipUnless(platform.system() == "Linux" and "BSIM_OUT_PATH" in os.environ,
+                         "BLE tests need Linux and BabbleSim (BSIM_OUT_PATH)")
+    def test_zmk_ble_test(self):
+        result = subprocess.run(
+            ["python3", str(THIS_DIR / "tests" / "ble" / "run.py")],
+            capture_output=True,
+            text=True,
+            cwd=THIS_DIR,
+        )
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        self.assertIn("PASS: profiles", result.stdout)
+        self.assertIn("PASS: split", result.stdout)
+        self.assertIn("PASS: studio", result.stdout)
+
     def test_zmk_build(self):
         artifacts_and_expected_config: dict[str, list[str | NotFound]] = {
             "my_awesome_keyboard_with_custom_rpc_support": [
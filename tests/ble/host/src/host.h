@@ -0,0 +1,14 @@
+/**
+ * Output of the simulated host, read back by tests/ble/run.py
+ */
+
+#pragma once
+
+#include <zephyr/sys/printk.h>
+
+/**
+ * Prefix of every printed line, from the -name option
+ */
+extern char *host_name;
+
+#define HOST_LOG(fmt, ...) printk("%s: " fmt "\n", host_name, ##__VA_ARGS__)
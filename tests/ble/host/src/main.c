@@ -0,0 +1,258 @@
+/**
+ * Simulated BLE HID host for the nrf52_bsim tests
+ *
+ * Scans for a keyboard advertising the HID service (or advertising directed
+ * at us), connects, pairs and subscribes to every HID input report. After a
+ * disconnect it scans again; if the keyboard has forgotten the bond it drops
+ * its own copy and pairs again. Every step is printed as "<name>: <event>" so
+ * the runner can build snapshots and timing metrics from the simulation log.
+ *
+ * Options (after the BabbleSim arguments):
+ *   -name=<str>            Prefix of every printed line (default "host")
+ *   -start_delay_ms=<ms>   Wait before the first scan (default 0)
+ *   -rpc=<script>          Studio calls to make once secured (see studio.h)
+ */
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+
+#include "bs_cmd_line.h"
+#include "bs_dynargs.h"
+#include "host.h"
+#include "posix_native_task.h"
+#include "studio.h"
+
+#define MAX_REPORTS 4
+
+char *host_name = "host";
+static uint32_t start_delay_ms;
+
+static struct bt_conn *default_conn;
+
+static struct bt_gatt_discover_params discover_params;
+static struct bt_gatt_subscribe_params subscribe_params[MAX_REPORTS];
+static struct bt_gatt_discover_params ccc_discover_params[MAX_REPORTS];
+static uint16_t report_handles[MAX_REPORTS];
+static uint8_t report_count;
+
+static void host_register_args(void) {
+    static bs_args_struct_t args[] = {
+        {
+            .option   = "name",
+            .name     = "name",
+            .type     = 's',
+            .dest     = (void *)&host_name,
+            .descript = "Prefix of every printed line",
+        },
+        {
+            .option   = "start_delay_ms",
+            .name     = "ms",
+            .type     = 'u',
+            .dest     = (void *)&start_delay_ms,
+            .descript = "Wait before the first scan",
+        },
+        {
+            .option   = "rpc",
+            .name     = "script",
+            .type     = 's',
+            .dest     = (void *)&studio_script,
+            .descript = "Studio calls to make once secured",
+        },
+        ARG_TABLE_ENDMARKER,
+    };
+
+    bs_add_extra_dynargs(args);
+}
+
+NATIVE_TASK(host_register_args, PRE_BOOT_1, 100);
+
+static void start_scan(void);
+
+static bool ad_has_hids(struct bt_data *data, void *user_data) {
+    bool *found = user_data;
+
+    if (data->type != BT_DATA_UUID16_SOME && data->type != BT_DATA_UUID16_ALL) {
+        return true;
+    }
+
+    for (size_t i = 0; i + 1 < data->data_len; i += 2) {
+        if (sys_get_le16(&data->data[i]) == BT_UUID_HIDS_VAL) {
+            *found = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+                         struct net_buf_simple *ad) {
+    if (default_conn) {
+        return;
+    }
+
+    // Directed advertising only reaches us if it targets our address
+    bool hids = type == BT_GAP_ADV_TYPE_ADV_DIRECT_IND;
+    if (type == BT_GAP_ADV_TYPE_ADV_IND) {
+        bt_data_parse(ad, ad_has_hids, &hids);
+    }
+    if (!hids) {
+        return;
+    }
+
+    if (bt_le_scan_stop()) {
+        return;
+    }
+
+    int err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN,
+                                BT_LE_CONN_PARAM_DEFAULT, &default_conn);
+    if (err) {
+        HOST_LOG("create connection failed (err %d)", err);
+        start_scan();
+    }
+}
+
+static void start_scan(void) {
+    int err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+    if (err) {
+        HOST_LOG("scan failed (err %d)", err);
+        return;
+    }
+    HOST_LOG("scanning");
+}
+
+static uint8_t notify_cb(struct bt_conn *conn,
+                         struct bt_gatt_subscribe_params *params,
+                         const void *data, uint16_t length) {
+    if (!data) {
+        params->value_handle = 0;
+        return BT_GATT_ITER_STOP;
+    }
+
+    char hex[3 * 16 + 1] = "";
+    const uint8_t *bytes = data;
+    for (uint16_t i = 0; i < length && i < 16; i++) {
+        snprintk(&hex[3 * i], sizeof(hex) - 3 * i, i ? " %02x" : "%02x",
+                 bytes[i]);
+    }
+    HOST_LOG("report %s", hex);
+    return BT_GATT_ITER_CONTINUE;
+}
+
+static void subscribe_reports(struct bt_conn *conn) {
+    for (uint8_t i = 0; i < report_count; i++) {
+        subscribe_params[i] = (struct bt_gatt_subscribe_params){
+            .notify       = notify_cb,
+            .value_handle = report_handles[i],
+            .ccc_handle   = 0,  // Discovered by the stack
+            .end_handle   = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+            .disc_params  = &ccc_discover_params[i],
+            .value        = BT_GATT_CCC_NOTIFY,
+        };
+
+        int err = bt_gatt_subscribe(conn, &subscribe_params[i]);
+        if (err && err != -EALREADY) {
+            HOST_LOG("subscribe failed (err %d)", err);
+        }
+    }
+    HOST_LOG("subscribed");
+    studio_start(conn);
+}
+
+static uint8_t discover_cb(struct bt_conn *conn,
+                           const struct bt_gatt_attr *attr,
+                           struct bt_gatt_discover_params *params) {
+    if (!attr) {
+        subscribe_reports(conn);
+        return BT_GATT_ITER_STOP;
+    }
+
+    // Output reports (LEDs) share the UUID but cannot notify
+    const struct bt_gatt_chrc *chrc = attr->user_data;
+    if ((chrc->properties & BT_GATT_CHRC_NOTIFY) &&
+        report_count < MAX_REPORTS) {
+        report_handles[report_count++] = chrc->value_handle;
+    }
+    return BT_GATT_ITER_CONTINUE;
+}
+
+static void discover_reports(struct bt_conn *conn) {
+    report_count    = 0;
+    discover_params = (struct bt_gatt_discover_params){
+        .uuid         = BT_UUID_HIDS_REPORT,
+        .func         = discover_cb,
+        .start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE,
+        .end_handle   = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+        .type         = BT_GATT_DISCOVER_CHARACTERISTIC,
+    };
+
+    int err = bt_gatt_discover(conn, &discover_params);
+    if (err) {
+        HOST_LOG("discover failed (err %d)", err);
+    }
+}
+
+static void connected(struct bt_conn *conn, uint8_t err) {
+    if (err) {
+        HOST_LOG("connection failed (err 0x%02x)", err);
+        bt_conn_unref(default_conn);
+        default_conn = NULL;
+        start_scan();
+        return;
+    }
+
+    HOST_LOG("connected");
+    err = bt_conn_set_security(conn, BT_SECURITY_L2);
+    if (err) {
+        HOST_LOG("set security failed (err %d)", err);
+    }
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason) {
+    if (conn != default_conn) {
+        return;
+    }
+
+    HOST_LOG("disconnected (reason 0x%02x)", reason);
+    studio_stop();
+    bt_conn_unref(default_conn);
+    default_conn = NULL;
+    start_scan();
+}
+
+static void security_changed(struct bt_conn *conn, bt_security_t level,
+                             enum bt_security_err err) {
+    if (err) {
+        HOST_LOG("security failed (err %d)", err);
+        // The keyboard was unpaired; forget it too so the retry pairs anew
+        if (err == BT_SECURITY_ERR_PIN_OR_KEY_MISSING) {
+            bt_unpair(BT_ID_DEFAULT, bt_conn_get_dst(conn));
+        }
+        return;
+    }
+
+    HOST_LOG("secured (level %d)", level);
+    discover_reports(conn);
+}
+
+BT_CONN_CB_DEFINE(host_conn_callbacks) = {
+    .connected        = connected,
+    .disconnected     = disconnected,
+    .security_changed = security_changed,
+};
+
+int main(void) {
+    int err = bt_enable(NULL);
+    if (err) {
+        HOST_LOG("bluetooth init failed (err %d)", err);
+        return 0;
+    }
+
+    k_msleep(start_delay_ms);
+    start_scan();
+    return 0;
+}
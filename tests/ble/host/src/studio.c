@@ -0,0 +1,428 @@
+/**
+ * Studio RPC client of the simulated host
+ *
+ * Talks to the keyboard the way ZMK Studio does over BLE: zmk.studio
+ * requests, framed with SOF/ESC/EOF bytes, are written to the Studio RPC
+ * characteristic and responses arrive framed the same way as indications.
+ * ble_management requests travel as the payload of a custom subsystem call.
+ * Every call and its result is printed for the snapshot.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pb_decode.h>
+#include <pb_encode.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zmk/ble_management/ble_management.pb.h>
+#include <zmk/studio.pb.h>
+
+#include "host.h"
+#include "studio.h"
+
+// ZMK's Studio GATT service and RPC characteristic
+#define STUDIO_RPC_CHRC_UUID                                                   \
+    BT_UUID_128_ENCODE(0x00000001, 0x0196, 0x6107, 0xc967, 0xc5cfb1c2482a)
+
+// Framing of ZMK's Studio transports
+#define FRAMING_SOF 0xAB
+#define FRAMING_ESC 0xAC
+#define FRAMING_EOF 0xAD
+
+// ble_management is the only custom subsystem of the scenario keyboards
+#define CUSTOM_SUBSYSTEM_INDEX 0
+
+#define MAX_STEPS        16
+#define MAX_MESSAGE      320
+#define RESPONSE_TIMEOUT K_SECONDS(2)
+
+char *studio_script;
+
+enum step_op {
+    STEP_PROFILES,
+    STEP_NAME,
+    STEP_SWITCH,
+    STEP_UNPAIR,
+};
+
+struct step {
+    uint32_t delay_ms;
+    enum step_op op;
+    uint32_t index;
+    char name[32];
+};
+
+static struct step steps[MAX_STEPS];
+static size_t step_count;
+static size_t next_step;
+static bool parsed;
+
+static struct bt_conn *rpc_conn;
+static uint16_t rpc_handle;
+static uint32_t request_id;
+static struct bt_gatt_discover_params rpc_discover_params;
+static struct bt_gatt_discover_params rpc_ccc_discover_params;
+static struct bt_gatt_subscribe_params rpc_subscribe_params;
+
+static uint8_t rx_buf[MAX_MESSAGE];
+static size_t rx_len;
+static bool rx_in_frame;
+static bool rx_escaped;
+
+static void step_work_handler(struct k_work *work);
+static void timeout_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(step_work, step_work_handler);
+static K_WORK_DELAYABLE_DEFINE(timeout_work, timeout_work_handler);
+
+static bool parse_step(char *text, struct step *step) {
+    char *save;
+    char *delay = strtok_r(text, ":", &save);
+    char *op    = strtok_r(NULL, ":", &save);
+    char *index = strtok_r(NULL, ":", &save);
+    char *name  = strtok_r(NULL, ":", &save);
+
+    if (!delay || !op) {
+        return false;
+    }
+    *step = (struct step){.delay_ms = strtoul(delay, NULL, 10)};
+    if (index) {
+        step->index = strtoul(index, NULL, 10);
+    }
+
+    if (!strcmp(op, "profiles")) {
+        step->op = STEP_PROFILES;
+    } else if (!strcmp(op, "name") && index) {
+        step->op = STEP_NAME;
+        strncpy(step->name, name ? name : "", sizeof(step->name) - 1);
+    } else if (!strcmp(op, "switch") && index) {
+        step->op = STEP_SWITCH;
+    } else if (!strcmp(op, "unpair") && index) {
+        step->op = STEP_UNPAIR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static void parse_script(void) {
+    static char script[256];
+    char *save;
+
+    parsed = true;
+    strncpy(script, studio_script, sizeof(script) - 1);
+    for (char *text = strtok_r(script, ",", &save);
+         text && step_count < MAX_STEPS; text = strtok_r(NULL, ",", &save)) {
+        if (!parse_step(text, &steps[step_count])) {
+            HOST_LOG("rpc script: invalid step %s", text);
+            return;
+        }
+        step_count++;
+    }
+}
+
+static int write_frame(const uint8_t *msg, size_t len) {
+    uint8_t frame[2 * MAX_MESSAGE + 2];
+    size_t used = 0;
+
+    frame[used++] = FRAMING_SOF;
+    for (size_t i = 0; i < len; i++) {
+        if (msg[i] == FRAMING_SOF || msg[i] == FRAMING_ESC ||
+            msg[i] == FRAMING_EOF) {
+            frame[used++] = FRAMING_ESC;
+        }
+        frame[used++] = msg[i];
+    }
+    frame[used++] = FRAMING_EOF;
+
+    size_t chunk = bt_gatt_get_mtu(rpc_conn) - 3;
+    for (size_t offset = 0; offset < used;) {
+        size_t size = MIN(chunk, used - offset);
+        int err     = bt_gatt_write_without_response(
+            rpc_conn, rpc_handle, &frame[offset], size, false);
+        if (err == -ENOMEM) {
+            k_msleep(1);
+            continue;
+        }
+        if (err) {
+            return err;
+        }
+        offset += size;
+    }
+    return 0;
+}
+
+static int send_request(const zmk_ble_management_Request *req) {
+    zmk_studio_Request studio = zmk_studio_Request_init_zero;
+    studio.request_id         = ++request_id;
+    studio.which_subsystem    = zmk_studio_Request_custom_tag;
+    studio.subsystem.custom.which_request_type = zmk_custom_Request_call_tag;
+
+    zmk_custom_CallRequest *call = &studio.subsystem.custom.request_type.call;
+    call->subsystem_index        = CUSTOM_SUBSYSTEM_INDEX;
+
+    pb_ostream_t payload = pb_ostream_from_buffer(
+        call->payload.bytes, sizeof(call->payload.bytes));
+    if (!pb_encode(&payload, zmk_ble_management_Request_fields, req)) {
+        return -EINVAL;
+    }
+    call->payload.size = payload.bytes_written;
+
+    uint8_t msg[MAX_MESSAGE];
+    pb_ostream_t stream = pb_ostream_from_buffer(msg, sizeof(msg));
+    if (!pb_encode(&stream, zmk_studio_Request_fields, &studio)) {
+        return -EINVAL;
+    }
+    return write_frame(msg, stream.bytes_written);
+}
+
+static void run_step(const struct step *step) {
+    zmk_ble_management_Request req = zmk_ble_management_Request_init_zero;
+
+    switch (step->op) {
+    case STEP_PROFILES:
+        HOST_LOG("rpc profiles");
+        req.which_request_type = zmk_ble_management_Request_get_profiles_tag;
+        break;
+    case STEP_NAME:
+        HOST_LOG("rpc name %u \"%s\"", step->index, step->name);
+        req.which_request_type =
+            zmk_ble_management_Request_set_profile_name_tag;
+        req.request_type.set_profile_name.index = step->index;
+        strcpy(req.request_type.set_profile_name.name, step->name);
+        break;
+    case STEP_SWITCH:
+        HOST_LOG("rpc switch %u", step->index);
+        req.which_request_type = zmk_ble_management_Request_switch_profile_tag;
+        req.request_type.switch_profile.index = step->index;
+        break;
+    case STEP_UNPAIR:
+        HOST_LOG("rpc unpair %u", step->index);
+        req.which_request_type = zmk_ble_management_Request_unpair_profile_tag;
+        req.request_type.unpair_profile.index = step->index;
+        break;
+    }
+
+    int err = send_request(&req);
+    if (err) {
+        HOST_LOG("rpc send failed (err %d)", err);
+        return;
+    }
+    k_work_reschedule(&timeout_work, RESPONSE_TIMEOUT);
+}
+
+static void schedule_next_step(void) {
+    if (rpc_conn && next_step < step_count) {
+        k_work_reschedule(&step_work, K_MSEC(steps[next_step].delay_ms));
+    }
+}
+
+static void step_work_handler(struct k_work *work) {
+    if (rpc_conn && next_step < step_count) {
+        run_step(&steps[next_step]);
+    }
+}
+
+static void timeout_work_handler(struct k_work *work) {
+    HOST_LOG("rpc timed out");
+    next_step++;
+    schedule_next_step();
+}
+
+static void print_response(const zmk_ble_management_Response *resp) {
+    switch (resp->which_response_type) {
+    case zmk_ble_management_Response_get_profiles_tag: {
+        const zmk_ble_management_GetProfilesResponse *profiles =
+            &resp->response_type.get_profiles;
+        for (pb_size_t i = 0; i < profiles->profiles_count; i++) {
+            const zmk_ble_management_ProfileInfo *p = &profiles->profiles[i];
+            HOST_LOG("profile %u %s%s%s \"%s\"", p->index,
+                     p->is_open ? "open" : "bonded",
+                     p->is_connected ? " connected" : "",
+                     p->is_active ? " active" : "", p->name);
+        }
+        break;
+    }
+    case zmk_ble_management_Response_set_profile_name_tag:
+        HOST_LOG("rpc %s", resp->response_type.set_profile_name.success
+                               ? "ok"
+                               : "failed");
+        break;
+    case zmk_ble_management_Response_switch_profile_tag:
+        HOST_LOG("rpc %s",
+                 resp->response_type.switch_profile.success ? "ok" : "failed");
+        break;
+    case zmk_ble_management_Response_unpair_profile_tag:
+        HOST_LOG("rpc %s",
+                 resp->response_type.unpair_profile.success ? "ok" : "failed");
+        break;
+    case zmk_ble_management_Response_error_tag:
+        HOST_LOG("rpc error \"%s\"", resp->response_type.error.message);
+        break;
+    default:
+        HOST_LOG("rpc unexpected response %d", resp->which_response_type);
+        break;
+    }
+}
+
+static void handle_message(const uint8_t *msg, size_t len) {
+    zmk_studio_Response studio = zmk_studio_Response_init_zero;
+    pb_istream_t stream        = pb_istream_from_buffer(msg, len);
+    if (!pb_decode(&stream, zmk_studio_Response_fields, &studio)) {
+        HOST_LOG("rpc undecodable message");
+        return;
+    }
+
+    // Notifications (e.g. lock state) are not answers
+    if (studio.which_type != zmk_studio_Response_request_response_tag) {
+        return;
+    }
+
+    const zmk_studio_RequestResponse *rr = &studio.type.request_response;
+    if (rr->request_id != request_id) {
+        return;
+    }
+    k_work_cancel_delayable(&timeout_work);
+
+    if (rr->which_subsystem != zmk_studio_RequestResponse_custom_tag ||
+        rr->subsystem.custom.which_response_type !=
+            zmk_custom_Response_call_tag) {
+        HOST_LOG("rpc refused by studio (subsystem %d)", rr->which_subsystem);
+    } else {
+        const zmk_custom_CallResponse *call =
+            &rr->subsystem.custom.response_type.call;
+        zmk_ble_management_Response resp =
+            zmk_ble_management_Response_init_zero;
+        pb_istream_t payload =
+            pb_istream_from_buffer(call->payload.bytes, call->payload.size);
+        if (pb_decode(&payload, zmk_ble_management_Response_fields, &resp)) {
+            print_response(&resp);
+        } else {
+            HOST_LOG("rpc undecodable payload");
+        }
+    }
+
+    next_step++;
+    schedule_next_step();
+}
+
+static void receive_byte(uint8_t byte) {
+    if (!rx_in_frame) {
+        if (byte == FRAMING_SOF) {
+            rx_in_frame = true;
+            rx_escaped  = false;
+            rx_len      = 0;
+        }
+        return;
+    }
+
+    if (!rx_escaped) {
+        switch (byte) {
+        case FRAMING_ESC:
+            rx_escaped = true;
+            return;
+        case FRAMING_SOF:
+            rx_len = 0;
+            return;
+        case FRAMING_EOF:
+            rx_in_frame = false;
+            handle_message(rx_buf, rx_len);
+            return;
+        default:
+            break;
+        }
+    }
+
+    rx_escaped = false;
+    if (rx_len == sizeof(rx_buf)) {
+        HOST_LOG("rpc message too long");
+        rx_in_frame = false;
+        return;
+    }
+    rx_buf[rx_len++] = byte;
+}
+
+static uint8_t rpc_indicate_cb(struct bt_conn *conn,
+                               struct bt_gatt_subscribe_params *params,
+                               const void *data, uint16_t length) {
+    if (!data) {
+        params->value_handle = 0;
+        return BT_GATT_ITER_STOP;
+    }
+
+    const uint8_t *bytes = data;
+    for (uint16_t i = 0; i < length; i++) {
+        receive_byte(bytes[i]);
+    }
+    return BT_GATT_ITER_CONTINUE;
+}
+
+static uint8_t rpc_discover_cb(struct bt_conn *conn,
+                               const struct bt_gatt_attr *attr,
+                               struct bt_gatt_discover_params *params) {
+    if (!attr) {
+        HOST_LOG("rpc characteristic not found");
+        return BT_GATT_ITER_STOP;
+    }
+
+    const struct bt_gatt_chrc *chrc = attr->user_data;
+    rpc_handle                      = chrc->value_handle;
+    rpc_subscribe_params            = (struct bt_gatt_subscribe_params){
+                   .notify       = rpc_indicate_cb,
+                   .value_handle = rpc_handle,
+                   .ccc_handle   = 0,  // Discovered by the stack
+                   .end_handle   = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+                   .disc_params  = &rpc_ccc_discover_params,
+                   .value        = BT_GATT_CCC_INDICATE,
+    };
+
+    int err = bt_gatt_subscribe(conn, &rpc_subscribe_params);
+    if (err && err != -EALREADY) {
+        HOST_LOG("rpc subscribe failed (err %d)", err);
+        return BT_GATT_ITER_STOP;
+    }
+
+    rx_in_frame = false;
+    schedule_next_step();
+    return BT_GATT_ITER_STOP;
+}
+
+void studio_start(struct bt_conn *conn) {
+    static const struct bt_uuid_128 rpc_uuid =
+        BT_UUID_INIT_128(STUDIO_RPC_CHRC_UUID);
+
+    if (!studio_script) {
+        return;
+    }
+    if (!parsed) {
+        parse_script();
+    }
+    if (next_step >= step_count) {
+        return;
+    }
+
+    rpc_conn            = bt_conn_ref(conn);
+    rpc_discover_params = (struct bt_gatt_discover_params){
+        .uuid         = &rpc_uuid.uuid,
+        .func         = rpc_discover_cb,
+        .start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE,
+        .end_handle   = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+        .type         = BT_GATT_DISCOVER_CHARACTERISTIC,
+    };
+
+    int err = bt_gatt_discover(conn, &rpc_discover_params);
+    if (err) {
+        HOST_LOG("rpc discover failed (err %d)", err);
+    }
+}
+
+void studio_stop(void) {
+    k_work_cancel_delayable(&step_work);
+    k_work_cancel_delayable(&timeout_work);
+    if (rpc_conn) {
+        bt_conn_unref(rpc_conn);
+        rpc_conn = NULL;
+    }
+}
@@ -0,0 +1,25 @@
+/**
+ * Studio RPC client of the simulated host
+ */
+
+#pragma once
+
+#include <zephyr/bluetooth/conn.h>
+
+/**
+ * Script of ble_management calls, from the -rpc option. Steps are separated
+ * by commas and run one after the other, each after its delay:
+ *   <delay_ms>:profiles
+ *   <delay_ms>:name:<index>:<name>
+ *   <delay_ms>:switch:<index>
+ *   <delay_ms>:unpair:<index>
+ */
+extern char *studio_script;
+
+/**
+ * Find the Studio RPC characteristic on a secured connection and start the
+ * script. Does nothing without a script or once it has run.
+ */
+void studio_start(struct bt_conn *conn);
+
+void studio_stop(void);
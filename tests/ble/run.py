@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Run the nrf52_bsim BLE scenarios under tests/ble.
+
+Each scenario directory holds the keyboard's ZMK config (nrf52_bsim.conf and
+nrf52_bsim.keymap), an optional peripheral/ config for split scenarios and:
+
+  hosts.txt        one simulated host (tests/ble/host) per line, with its args
+  events.patterns  sed -E script turning the merged log into the snapshot
+  snapshot.log     expected filtered output, recorded by the first run
+  metrics.txt      "name | start regex | end regex" timing metrics
+
+Devices are numbered keyboard, peripheral, hosts. Their BabbleSim output is
+merged by simulated time, filtered and compared against the snapshot; metrics
+are the simulated time between the first start line and the next end line.
+A scenario without a snapshot fails once and leaves the recorded one for
+review. Hosts can make Studio RPC calls with -rpc (see host/src/studio.h).
+
+Requires BSIM_OUT_PATH and BSIM_COMPONENTS_PATH (see the Zephyr BabbleSim
+docs) and a west workspace. Linux only.
+
+  python3 tests/ble/run.py [--update] [scenario ...]
+"""
+
+import argparse
+import os
+import re
+import shlex
+import subprocess
+import sys
+from pathlib import Path
+
+THIS_DIR = Path(__file__).parent.resolve()
+MODULE_DIR = THIS_DIR.parent.parent
+BOARD = "nrf52_bsim"
+SIM_LENGTH_US = 20_000_000
+
+# "d_00: @00:00:01.234567  <text>"
+LOG_LINE = re.compile(r"^d_(\d+): @(\d+):(\d+):(\d+)\.(\d+)\s+(.*)$")
+
+
+def run(args: list[str], **kwargs) -> subprocess.CompletedProcess[str]:
+    return subprocess.run(args, capture_output=True, text=True, **kwargs)
+
+
+def west_build(build_dir: Path, source: Path, *cmake_args: str) -> None:
+    result = run(["west", "build", "-p", "-b", BOARD, "-d", str(build_dir),
+                  str(source), "--", *cmake_args])
+    if result.returncode != 0:
+        sys.exit(f"Build of {source} failed:\n{result.stdout}{result.stderr}")
+
+
+def zmk_app_dir() -> Path:
+    result = run(["west", "list", "-f", "{abspath}", "zmk"])
+    if result.returncode != 0:
+        sys.exit("zmk is not part of the west workspace")
+    return Path(result.stdout.strip()) / "app"
+
+
+def merge_logs(logs: list[Path]) -> list[tuple[int, str]]:
+    """Merge per-device output into (time in us, line) sorted by time."""
+    lines: list[tuple[int, int, int, str]] = []
+    for log in logs:
+        for order, raw in enumerate(log.read_text(errors="replace").splitlines()):
+            match = LOG_LINE.match(raw)
+            if not match:
+                continue
+            dev, h, m, s, us, _ = match.groups()
+            t = ((int(h) * 60 + int(m)) * 60 + int(s)) * 1_000_000 + int(us)
+            lines.append((t, int(dev), order, raw))
+    lines.sort()
+    return [(t, raw) for t, _, _, raw in lines]
+
+
+def read_metrics(path: Path) -> list[tuple[str, re.Pattern, re.Pattern]]:
+    metrics = []
+    if not path.exists():
+        return metrics
+    for line in path.read_text().splitlines():
+        if not line.strip() or line.startswith("#"):
+            continue
+        name, start, end = (part.strip() for part in line.split("|"))
+        metrics.append((name, re.compile(start), re.compile(end)))
+    return metrics
+
+
+def compute_metric(log: list[tuple[int, str]], start: re.Pattern,
+                   end: re.Pattern) -> float | None:
+    start_at = next((t for t, raw in log if start.search(raw)), None)
+    if start_at is None:
+        return None
+    end_at = next((t for t, raw in log if t >= start_at and end.search(raw)),
+                  None)
+    return None if end_at is None else (end_at - start_at) / 1000
+
+
+def run_scenario(scenario: Path, host_exe: Path, zmk_app: Path,
+                 build_root: Path, update: bool) -> bool:
+    name = scenario.name
+    build_dir = build_root / name
+    extra = [f"-DZMK_EXTRA_MODULES={MODULE_DIR}"]
+
+    exes = []
+    west_build(build_dir / "keyboard", zmk_app, f"-DZMK_CONFIG={scenario}",
+               *extra)
+    exes.append([build_dir / "keyboard" / "zephyr" / "zmk.exe"])
+    if (scenario / "peripheral").is_dir():
+        west_build(build_dir / "peripheral", zmk_app,
+                   f"-DZMK_CONFIG={scenario / 'peripheral'}", *extra)
+        exes.append([build_dir / "peripheral" / "zephyr" / "zmk.exe"])
+    for line in (scenario / "hosts.txt").read_text().splitlines():
+        if line.strip() and not line.startswith("#"):
+            exes.append([host_exe, *shlex.split(line)])
+
+    bsim_bin = Path(os.environ["BSIM_OUT_PATH"]) / "bin"
+    sim_id = f"ble_management_{name}"
+    logs = [build_dir / f"device_{i}.log" for i in range(len(exes))]
+
+    procs = [subprocess.Popen(
+        [str(bsim_bin / "bs_2G4_phy_v1"), f"-s={sim_id}", f"-D={len(exes)}",
+         f"-sim_length={SIM_LENGTH_US}"],
+        cwd=bsim_bin, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)]
+    for i, (exe, *args) in enumerate(exes):
+        with logs[i].open("w") as out:
+            procs.append(subprocess.Popen(
+                [str(exe), f"-s={sim_id}", f"-d={i}", *args],
+                cwd=bsim_bin, stdout=out, stderr=subprocess.STDOUT))
+    for proc in procs:
+        proc.wait()
+
+    log = merge_logs(logs)
+    (build_dir / "output.log").write_text("".join(f"{raw}\n" for _, raw in log))
+
+    filtered = run(["sed", "-E", "-n", "-f", str(scenario / "events.patterns"),
+                    str(build_dir / "output.log")]).stdout
+    (build_dir / "filtered_output.log").write_text(filtered)
+
+    metrics = []
+    for metric, start, end in read_metrics(scenario / "metrics.txt"):
+        value = compute_metric(log, start, end)
+        metrics.append(f"METRIC {name} {metric} "
+                       f"{'n/a' if value is None else f'{value:.3f}'}")
+    (build_dir / "metrics.log").write_text("".join(f"{m}\n" for m in metrics))
+    print("\n".join(metrics))
+
+    snapshot = scenario / "snapshot.log"
+    if update:
+        snapshot.write_text(filtered)
+    elif not snapshot.exists():
+        # Recorded from this run; review and commit it, then run again
+        snapshot.write_text(filtered)
+        print(f"New snapshot {snapshot}:\n{filtered}")
+        print(f"FAIL: {name}")
+        return False
+    elif snapshot.read_text() != filtered:
+        diff = run(["diff", "-u", str(snapshot), str(build_dir / "filtered_output.log")])
+        print(diff.stdout)
+        print(f"FAIL: {name}")
+        return False
+    print(f"PASS: {name}")
+    return True
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("scenarios", nargs="*",
+                        help="Scenario directory names (default: all)")
+    parser.add_argument("--update", action="store_true",
+                        help="Write the filtered output as the new snapshot")
+    args = parser.parse_args()
+
+    for var in ("BSIM_OUT_PATH", "BSIM_COMPONENTS_PATH"):
+        if var not in os.environ:
+            sys.exit(f"{var} is not set")
+
+    topdir = Path(run(["west", "topdir"]).stdout.strip())
+    build_root = topdir / "build" / "tests" / "ble"
+
+    west_build(build_root / "host", THIS_DIR / "host")
+    host_exe = build_root / "host" / "zephyr" / "zephyr.exe"
+
+    scenarios = [THIS_DIR / s for s in args.scenarios] or sorted(
+        d for d in THIS_DIR.iterdir() if (d / "hosts.txt").exists())
+    zmk_app = zmk_app_dir()
+    results = [run_scenario(s, host_exe, zmk_app, build_root, args.update)
+               for s in scenarios]
+    return 0 if all(results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
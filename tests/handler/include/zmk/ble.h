@@ -0,0 +1,19 @@
+/**
+ * Fake of the ZMK BLE profile API, backed by struct fake_zmk in fakes.c
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/addr.h>
+
+#define ZMK_BLE_PROFILE_COUNT 5
+
+void zmk_ble_clear_bonds(void);
+void zmk_ble_clear_all_bonds(void);
+int zmk_ble_prof_select(uint8_t index);
+int zmk_ble_active_profile_index(void);
+bool zmk_ble_profile_is_open(uint8_t index);
+bool zmk_ble_profile_is_connected(uint8_t index);
+bt_addr_le_t *zmk_ble_profile_address(uint8_t index);
@@ -0,0 +1,19 @@
+/**
+ * Fake of the ZMK endpoint selection API
+ */
+
+#pragma once
+
+enum zmk_transport {
+    ZMK_TRANSPORT_NONE,
+    ZMK_TRANSPORT_USB,
+    ZMK_TRANSPORT_BLE,
+};
+
+struct zmk_endpoint_instance {
+    enum zmk_transport transport;
+};
+
+int zmk_endpoints_select_transport(enum zmk_transport transport);
+enum zmk_transport zmk_endpoints_get_preferred_transport(void);
+struct zmk_endpoint_instance zmk_endpoints_selected(void);
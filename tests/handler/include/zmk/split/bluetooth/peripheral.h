@@ -0,0 +1,9 @@
+/**
+ * Fake of the ZMK split peripheral API
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+bool zmk_split_bt_peripheral_is_bonded(void);
@@ -0,0 +1,46 @@
+/**
+ * Fake of the custom Studio RPC subsystem API. The subsystem and response
+ * buffer macros expand to plain objects the harness reaches directly.
+ */
+
+#pragma once
+
+#include <pb.h>
+#include <string.h>
+
+#define ZMK_STUDIO_RPC_HANDLER_UNSECURED 0
+
+typedef struct {
+    uint32_t subsystem_index;
+    struct {
+        pb_size_t size;
+        pb_byte_t bytes[256];
+    } payload;
+} zmk_custom_CallRequest;
+
+typedef bool (*zmk_rpc_custom_subsystem_func)(
+    const zmk_custom_CallRequest *raw_request, pb_callback_t *encode_response);
+
+struct zmk_rpc_custom_subsystem_meta {
+    const char *const *ui_urls;
+    int security;
+};
+
+#define ZMK_RPC_CUSTOM_SUBSYSTEM_UI_URLS(...)                                  \
+    .ui_urls = (const char *const[]) { __VA_ARGS__, NULL }
+
+#define ZMK_RPC_CUSTOM_SUBSYSTEM(name, meta, func)                             \
+    static bool func(const zmk_custom_CallRequest *raw_request,                \
+                     pb_callback_t *encode_response);                          \
+    const zmk_rpc_custom_subsystem_func zmk_rpc_custom_##name##_func = func
+
+#define ZMK_RPC_CUSTOM_SUBSYSTEM_RESPONSE_BUFFER(name, type)                   \
+    static type zmk_rpc_custom_##name##_response
+
+#define ZMK_RPC_CUSTOM_SUBSYSTEM_RESPONSE_BUFFER_ALLOCATE(name, encode)        \
+    ({                                                                         \
+        ARG_UNUSED(encode);                                                    \
+        memset(&zmk_rpc_custom_##name##_response, 0,                           \
+               sizeof(zmk_rpc_custom_##name##_response));                      \
+        &zmk_rpc_custom_##name##_response;                                     \
+    })
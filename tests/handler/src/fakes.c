@@ -0,0 +1,196 @@
+/**
+ * Fake ZMK APIs and a RAM settings backend
+ *
+ * The bond table mirrors ZMK's: open profiles hold BT_ADDR_LE_ANY, clearing
+ * bonds only touches the active profile and bonds persist across simulated
+ * reboots like ZMK's own settings would. The settings store keeps every
+ * record in RAM so tests can reload it and measure its size.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/util.h>
+#include <zmk/split/bluetooth/peripheral.h>
+
+#include "fakes.h"
+
+#define FAKE_SETTINGS_MAX       32
+#define FAKE_SETTINGS_NAME_LEN  48
+#define FAKE_SETTINGS_VALUE_LEN 64
+
+struct fake_zmk fake_zmk;
+
+const bt_addr_le_t bt_addr_le_any  = {0, {{0, 0, 0, 0, 0, 0}}};
+const bt_addr_le_t bt_addr_le_none = {0, {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff}}};
+
+int bt_addr_le_from_str(const char *str, const char *type, bt_addr_le_t *addr) {
+    unsigned int b[6];
+    if (sscanf(str, "%2x:%2x:%2x:%2x:%2x:%2x", &b[0], &b[1], &b[2], &b[3],
+               &b[4], &b[5]) != 6) {
+        return -EINVAL;
+    }
+
+    if (!strcmp(type, "public") || !strcmp(type, "(public)")) {
+        addr->type = BT_ADDR_LE_PUBLIC;
+    } else if (!strcmp(type, "random") || !strcmp(type, "(random)")) {
+        addr->type = BT_ADDR_LE_RANDOM;
+    } else {
+        return -EINVAL;
+    }
+
+    // Strings are most significant byte first
+    for (int i = 0; i < 6; i++) {
+        addr->a.val[5 - i] = b[i];
+    }
+    return 0;
+}
+
+void fake_zmk_reset(void) {
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        bt_addr_le_copy(&fake_zmk.bonds[i], BT_ADDR_LE_ANY);
+    }
+    fake_zmk.active       = 0;
+    fake_zmk.preferred    = ZMK_TRANSPORT_USB;
+    fake_zmk.split_bonded = false;
+}
+
+int fake_zmk_pair(const bt_addr_le_t *addr) {
+    if (!zmk_ble_profile_is_open(fake_zmk.active)) {
+        return -EBUSY;
+    }
+    bt_addr_le_copy(&fake_zmk.bonds[fake_zmk.active], addr);
+    return 0;
+}
+
+void zmk_ble_clear_bonds(void) {
+    bt_addr_le_copy(&fake_zmk.bonds[fake_zmk.active], BT_ADDR_LE_ANY);
+}
+
+void zmk_ble_clear_all_bonds(void) {
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        bt_addr_le_copy(&fake_zmk.bonds[i], BT_ADDR_LE_ANY);
+    }
+    fake_zmk.split_bonded = false;
+}
+
+int zmk_ble_prof_select(uint8_t index) {
+    if (index >= ZMK_BLE_PROFILE_COUNT) {
+        return -ERANGE;
+    }
+    fake_zmk.active = index;
+    return 0;
+}
+
+int zmk_ble_active_profile_index(void) { return fake_zmk.active; }
+
+bool zmk_ble_profile_is_open(uint8_t index) {
+    return bt_addr_le_eq(&fake_zmk.bonds[index], BT_ADDR_LE_ANY);
+}
+
+bool zmk_ble_profile_is_connected(uint8_t index) { return false; }
+
+bt_addr_le_t *zmk_ble_profile_address(uint8_t index) {
+    return &fake_zmk.bonds[index];
+}
+
+int zmk_endpoints_select_transport(enum zmk_transport transport) {
+    fake_zmk.preferred = transport;
+    return 0;
+}
+
+enum zmk_transport zmk_endpoints_get_preferred_transport(void) {
+    return fake_zmk.preferred;
+}
+
+struct zmk_endpoint_instance zmk_endpoints_selected(void) {
+    return (struct zmk_endpoint_instance){.transport = fake_zmk.preferred};
+}
+
+bool zmk_split_bt_peripheral_is_bonded(void) { return fake_zmk.split_bonded; }
+
+static struct {
+    char name[FAKE_SETTINGS_NAME_LEN];
+    uint8_t value[FAKE_SETTINGS_VALUE_LEN];
+    size_t len;
+} records[FAKE_SETTINGS_MAX];
+static size_t record_count;
+
+static ssize_t record_read(void *cb_arg, void *data, size_t len) {
+    size_t i = (size_t)cb_arg;
+    len      = MIN(len, records[i].len);
+    memcpy(data, records[i].value, len);
+    return len;
+}
+
+static int ram_load(struct settings_store *cs,
+                    const struct settings_load_arg *arg) {
+    for (size_t i = 0; i < record_count; i++) {
+        if (arg && arg->subtree &&
+            !settings_name_steq(records[i].name, arg->subtree, NULL)) {
+            continue;
+        }
+        settings_call_set_handler(records[i].name, records[i].len,
+                                  record_read, (void *)i, arg);
+    }
+    return 0;
+}
+
+static int ram_save(struct settings_store *cs, const char *name,
+                    const char *value, size_t val_len) {
+    size_t i = 0;
+    while (i < record_count && strcmp(records[i].name, name)) {
+        i++;
+    }
+
+    // Zero length deletes
+    if (val_len == 0) {
+        if (i < record_count) {
+            records[i] = records[--record_count];
+        }
+        return 0;
+    }
+
+    if (strlen(name) >= FAKE_SETTINGS_NAME_LEN ||
+        val_len > FAKE_SETTINGS_VALUE_LEN) {
+        return -EINVAL;
+    }
+    if (i == record_count) {
+        if (record_count == FAKE_SETTINGS_MAX) {
+            return -ENOMEM;
+        }
+        record_count++;
+    }
+    strcpy(records[i].name, name);
+    memcpy(records[i].value, value, val_len);
+    records[i].len = val_len;
+    return 0;
+}
+
+static const struct settings_store_itf ram_itf = {
+    .csi_load = ram_load,
+    .csi_save = ram_save,
+};
+
+static struct settings_store ram_store = {
+    .cs_itf = &ram_itf,
+};
+
+int settings_backend_init(void) {
+    settings_dst_register(&ram_store);
+    settings_src_register(&ram_store);
+    return 0;
+}
+
+void fake_settings_clear(void) { record_count = 0; }
+
+size_t fake_settings_count(void) { return record_count; }
+
+size_t fake_settings_bytes(void) {
+    size_t bytes = 0;
+    for (size_t i = 0; i < record_count; i++) {
+        bytes += strlen(records[i].name) + records[i].len;
+    }
+    return bytes;
+}
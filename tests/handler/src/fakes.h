@@ -0,0 +1,34 @@
+/**
+ * Control over the fake ZMK state and settings storage
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/bluetooth/addr.h>
+#include <zmk/ble.h>
+#include <zmk/endpoints.h>
+
+struct fake_zmk {
+    // BT_ADDR_LE_ANY for open profiles, as in ZMK
+    bt_addr_le_t bonds[ZMK_BLE_PROFILE_COUNT];
+    int active;
+    enum zmk_transport preferred;
+    bool split_bonded;
+};
+
+extern struct fake_zmk fake_zmk;
+
+void fake_zmk_reset(void);
+
+/**
+ * A host pairs with the active profile, as ZMK would accept it.
+ * Returns -EBUSY if the active profile is already bonded.
+ */
+int fake_zmk_pair(const bt_addr_le_t *addr);
+
+// Settings storage that survives simulated reboots
+void fake_settings_clear(void);
+size_t fake_settings_count(void);
+size_t fake_settings_bytes(void);
@@ -0,0 +1,92 @@
+/**
+ * The handler is included rather than linked so its static state and the
+ * response buffer of the fake subsystem macros are reachable.
+ */
+
+#include <errno.h>
+#include <pb_encode.h>
+#include <time.h>
+#include <zephyr/settings/settings.h>
+
+#include "../../../src/studio/ble_management_handler.c"
+
+#include "harness.h"
+
+int harness_call(const zmk_ble_management_Request *req,
+                 zmk_ble_management_Response *resp) {
+    zmk_custom_CallRequest call = {0};
+
+    pb_ostream_t stream = pb_ostream_from_buffer(call.payload.bytes,
+                                                 sizeof(call.payload.bytes));
+    if (!pb_encode(&stream, zmk_ble_management_Request_fields, req)) {
+        return -EIO;
+    }
+    call.payload.size = stream.bytes_written;
+
+    pb_callback_t encode_response = {0};
+    zmk_rpc_custom_cormoran_ble_func(&call, &encode_response);
+    *resp = zmk_rpc_custom_cormoran_ble_response;
+    return 0;
+}
+
+void harness_reboot(void) {
+    profile_names_init();
+    settings_load();
+    // What the work item submitted by the settings commit handler does
+    bind_pending_names();
+}
+
+void harness_pairing_complete(void) { bind_pending_names(); }
+
+uint64_t harness_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static uint32_t rng_state = 1;
+
+void harness_rng_seed(uint32_t seed) { rng_state = seed; }
+
+uint32_t harness_rng_next(void) {
+    // xorshift32
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+uint32_t harness_rng_below(uint32_t n) { return harness_rng_next() % n; }
+
+size_t harness_pick_weighted(const uint16_t *weights, size_t count) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += weights[i];
+    }
+
+    uint32_t pick = harness_rng_below(total);
+    for (size_t i = 0; i < count; i++) {
+        if (pick < weights[i]) {
+            return i;
+        }
+        pick -= weights[i];
+    }
+    return count - 1;
+}
+
+void harness_random_addr(bt_addr_le_t *addr) {
+    addr->type = harness_rng_below(2) ? BT_ADDR_LE_RANDOM : BT_ADDR_LE_PUBLIC;
+    for (int i = 0; i < 6; i++) {
+        addr->a.val[i] = harness_rng_next();
+    }
+    addr->a.val[0] = (addr->a.val[0] | 0x02) & 0xfe;
+}
+
+void harness_random_name(char *name, size_t size) {
+    static const char chars[] = "abcdefghijklmnopqrstuvwxyz0123456789 -_";
+    size_t len = harness_rng_below(size);
+    for (size_t i = 0; i < len; i++) {
+        name[i] = chars[harness_rng_below(sizeof(chars) - 1)];
+    }
+    name[len] = '\0';
+}
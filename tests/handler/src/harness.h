@@ -0,0 +1,59 @@
+/**
+ * Drives the Studio RPC handler the way the custom subsystem would
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/addr.h>
+#include <zmk/ble_management/ble_management.pb.h>
+
+/**
+ * Encode a request, run it through the handler and return its response.
+ * Returns -EIO if the request cannot be encoded.
+ */
+int harness_call(const zmk_ble_management_Request *req,
+                 zmk_ble_management_Response *resp);
+
+/**
+ * Simulated reboot: the handler's state is initialized again and reloaded
+ * from the settings store; the fake ZMK bond table is kept.
+ */
+void harness_reboot(void);
+
+/**
+ * What the handler's pairing complete callback does once ZMK has bonded a
+ * host to a profile. The test build has no Bluetooth host to call it.
+ */
+void harness_pairing_complete(void);
+
+/**
+ * Host monotonic clock. Simulated time does not advance while the handler
+ * runs, so latencies are measured in host time.
+ */
+uint64_t harness_now_ns(void);
+
+/**
+ * Deterministic pseudo-random numbers (xorshift32) for the randomized tests,
+ * so a failing run can be replayed from its seed. The seed must not be 0.
+ */
+void harness_rng_seed(uint32_t seed);
+uint32_t harness_rng_next(void);
+uint32_t harness_rng_below(uint32_t n);
+
+/**
+ * Index into weights picked with probability proportional to its weight
+ */
+size_t harness_pick_weighted(const uint16_t *weights, size_t count);
+
+/**
+ * Random public or random address that never equals the open/empty markers
+ * (all 0x00 / all 0xff)
+ */
+void harness_random_addr(bt_addr_le_t *addr);
+
+/**
+ * Random name of 0 to size - 1 characters, NUL terminated
+ */
+void harness_random_name(char *name, size_t size);
@@ -0,0 +1,195 @@
+/**
+ * Metrics registry read through GetMetricsSchema and GetMetrics
+ *
+ * Metrics defined here sit in the registry next to the handler's own. The
+ * schema and the dump are read page by page the way a host would, the dump
+ * is decoded with the schema and the values of the test metrics are
+ * checked.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zmk/ble_management/metrics.h>
+
+#include "harness.h"
+
+#define MAX_METRICS 32
+#define MAX_VALUES  (MAX_METRICS * ZMK_BLE_MGMT_METRIC_MAX_BUCKETS)
+
+ZMK_BLE_MGMT_METRIC_COUNTER_DEFINE(test_metric_counter, "test_counter");
+ZMK_BLE_MGMT_METRIC_GAUGE_DEFINE(test_metric_gauge, "test_gauge");
+ZMK_BLE_MGMT_METRIC_HISTOGRAM_DEFINE(test_metric_histogram, "test_histogram",
+                                     10, 100, UINT32_MAX);
+
+struct schema {
+    uint32_t id;
+    uint32_t count;
+    zmk_ble_management_MetricInfo metrics[MAX_METRICS];
+};
+
+static struct schema schema;
+static uint32_t values[MAX_VALUES];
+
+static void read_schema(void) {
+    zmk_ble_management_Request req = zmk_ble_management_Request_init_zero;
+    zmk_ble_management_Response resp;
+    uint32_t first = 0;
+
+    req.which_request_type = zmk_ble_management_Request_get_metrics_schema_tag;
+    do {
+        req.request_type.get_metrics_schema.first = first;
+        zassert_ok(harness_call(&req, &resp));
+        zassert_equal(resp.which_response_type,
+                      zmk_ble_management_Response_get_metrics_schema_tag);
+
+        const zmk_ble_management_GetMetricsSchemaResponse *page =
+            &resp.response_type.get_metrics_schema;
+        zassert_true(page->count <= MAX_METRICS);
+        zassert_equal(page->first, first);
+        zassert_true(page->metrics_count > 0, "empty page at %u", first);
+        if (first == 0) {
+            schema.id    = page->schema_id;
+            schema.count = page->count;
+        }
+        zassert_equal(page->schema_id, schema.id);
+
+        memcpy(&schema.metrics[first], page->metrics,
+               page->metrics_count * sizeof(page->metrics[0]));
+        first += page->metrics_count;
+    } while (first < schema.count);
+}
+
+static int find_metric(const char *name) {
+    for (uint32_t i = 0; i < schema.count; i++) {
+        if (!strcmp(schema.metrics[i].name, name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static size_t metric_values(uint32_t index) {
+    const zmk_ble_management_MetricInfo *info = &schema.metrics[index];
+    return info->type == zmk_ble_management_MetricType_METRIC_TYPE_HISTOGRAM
+               ? info->bucket_bounds_count
+               : 1;
+}
+
+static const uint8_t *varint_get(const uint8_t *p, const uint8_t *end,
+                                 uint32_t *value) {
+    *value = 0;
+    for (int shift = 0; p < end && shift < 35; shift += 7) {
+        *value |= (uint32_t)(*p & 0x7f) << shift;
+        if (!(*p++ & 0x80)) {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Read every value; offsets[i] is where metric i starts in values
+ */
+static void read_values(size_t offsets[MAX_METRICS]) {
+    zmk_ble_management_Request req = zmk_ble_management_Request_init_zero;
+    zmk_ble_management_Response resp;
+    uint32_t first = 0;
+    size_t used    = 0;
+
+    req.which_request_type = zmk_ble_management_Request_get_metrics_tag;
+    while (first < schema.count) {
+        req.request_type.get_metrics.first = first;
+        zassert_ok(harness_call(&req, &resp));
+        zassert_equal(resp.which_response_type,
+                      zmk_ble_management_Response_get_metrics_tag);
+
+        const zmk_ble_management_GetMetricsResponse *page =
+            &resp.response_type.get_metrics;
+        zassert_equal(page->schema_id, schema.id);
+        zassert_equal(page->first, first);
+        zassert_true(page->next > first && page->next <= schema.count);
+
+        const uint8_t *p   = page->values.bytes;
+        const uint8_t *end = p + page->values.size;
+        for (uint32_t m = first; m < page->next; m++) {
+            offsets[m] = used;
+            for (size_t v = 0; v < metric_values(m); v++) {
+                p = varint_get(p, end, &values[used]);
+                zassert_not_null(p, "dump of metric %u truncated", m);
+                if (schema.metrics[m].type ==
+                    zmk_ble_management_MetricType_METRIC_TYPE_GAUGE) {
+                    // Zigzag encoded
+                    values[used] = (values[used] >> 1) ^ -(values[used] & 1);
+                }
+                used++;
+            }
+        }
+        zassert_equal(p, end, "trailing bytes after metric %u", page->next);
+        first = page->next;
+    }
+}
+
+ZTEST(metrics, test_schema) {
+    read_schema();
+
+    int histogram = find_metric("test_histogram");
+    zassert_true(find_metric("test_counter") >= 0);
+    zassert_true(find_metric("test_gauge") >= 0);
+    zassert_true(find_metric("rpc_requests") >= 0);
+    zassert_true(histogram >= 0);
+
+    const zmk_ble_management_MetricInfo *info = &schema.metrics[histogram];
+    zassert_equal(info->type,
+                  zmk_ble_management_MetricType_METRIC_TYPE_HISTOGRAM);
+    zassert_equal(info->bucket_bounds_count, 3);
+    zassert_equal(info->bucket_bounds[0], 10);
+    zassert_equal(info->bucket_bounds[2], UINT32_MAX);
+
+    // The schema is fixed at build time
+    uint32_t id = schema.id;
+    read_schema();
+    zassert_equal(schema.id, id);
+}
+
+ZTEST(metrics, test_values) {
+    static size_t offsets[MAX_METRICS];
+    read_schema();
+
+    ZMK_BLE_MGMT_METRIC_ADD(test_metric_counter, 300);
+    ZMK_BLE_MGMT_METRIC_INC(test_metric_counter);
+    ZMK_BLE_MGMT_METRIC_SET(test_metric_gauge, 70000);
+    ZMK_BLE_MGMT_METRIC_OBSERVE(test_metric_histogram, 3);
+    ZMK_BLE_MGMT_METRIC_OBSERVE(test_metric_histogram, 10);
+    ZMK_BLE_MGMT_METRIC_OBSERVE(test_metric_histogram, 99);
+    ZMK_BLE_MGMT_METRIC_OBSERVE(test_metric_histogram, UINT32_MAX);
+
+    read_values(offsets);
+    zassert_equal(values[offsets[find_metric("test_counter")]], 301);
+    zassert_equal(values[offsets[find_metric("test_gauge")]], 70000);
+
+    const uint32_t *buckets = &values[offsets[find_metric("test_histogram")]];
+    zassert_equal(buckets[0], 1);
+    zassert_equal(buckets[1], 2);
+    zassert_equal(buckets[2], 1);
+
+    // Gauges are signed
+    ZMK_BLE_MGMT_METRIC_SET(test_metric_gauge, -5);
+    read_values(offsets);
+    zassert_equal((int32_t)values[offsets[find_metric("test_gauge")]], -5);
+
+    // Every request is counted, including the ones reading the metrics
+    size_t requests = offsets[find_metric("rpc_requests")];
+    uint32_t before = values[requests];
+    read_values(offsets);
+    zassert_true(values[requests] > before);
+}
+
+static void metrics_before(void *fixture) {
+    atomic_clear(test_metric_counter.values);
+    atomic_clear(test_metric_gauge.values);
+    for (int i = 0; i < test_metric_histogram.buckets; i++) {
+        atomic_clear(&test_metric_histogram.values[i]);
+    }
+}
+
+ZTEST_SUITE(metrics, NULL, NULL, metrics_before, NULL, NULL);
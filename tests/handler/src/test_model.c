@@ -0,0 +1,281 @@
+/**
+ * Model-based randomized test of the profile operations
+ *
+ * Random sequences of pairing, renaming, switching, unpairing, keymap bond
+ * clears, split bond resets and reboots are applied both to the handler
+ * (through harness_call) and to a reference model. After every step the
+ * GetProfiles response must match the model and the settings store must not
+ * hold more names, pending or bound, than there are profiles. Sequences are
+ * seeded by their number so a failure can be replayed; the last steps are
+ * printed with it.
+ * The runtime of every sequence is reported and checked against a budget.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/ztest.h>
+
+#include "fakes.h"
+#include "harness.h"
+
+#define SEQUENCES          200
+#define STEPS_PER_SEQUENCE 250
+#define HISTORY_LEN        16
+
+// Generous on purpose: only pathological slowdowns should trip it
+#define SEQUENCE_BUDGET_US 500000
+
+#define NAME_LEN sizeof(((zmk_ble_management_ProfileInfo *)0)->name)
+
+enum model_op {
+    OP_PAIR,
+    OP_RENAME,
+    OP_SWITCH,
+    OP_UNPAIR,
+    OP_KEYMAP_CLEAR,
+    OP_FORGET_SPLIT,
+    OP_REBOOT,
+};
+
+static const uint16_t op_weights[] = {
+    [OP_PAIR] = 20,        [OP_RENAME] = 25,      [OP_SWITCH] = 20,
+    [OP_UNPAIR] = 10,      [OP_KEYMAP_CLEAR] = 8, [OP_FORGET_SPLIT] = 2,
+    [OP_REBOOT] = 15,
+};
+
+struct model {
+    bt_addr_le_t bonds[ZMK_BLE_PROFILE_COUNT];
+    char names[ZMK_BLE_PROFILE_COUNT][NAME_LEN];
+    int active;
+};
+
+static struct model model;
+static char history[HISTORY_LEN][64];
+static uint32_t history_count;
+
+static void record(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(history[history_count++ % HISTORY_LEN], sizeof(history[0]), fmt,
+              args);
+    va_end(args);
+}
+
+static void dump_history(uint32_t seq) {
+    uint32_t first = history_count > HISTORY_LEN ? history_count - HISTORY_LEN
+                                                 : 0;
+    TC_PRINT("sequence %u (seed %u) failed after step %u; last steps:\n", seq,
+             seq + 1, history_count);
+    for (uint32_t i = first; i < history_count; i++) {
+        TC_PRINT("  %u: %s\n", i, history[i % HISTORY_LEN]);
+    }
+}
+
+static bool model_is_open(int index) {
+    return bt_addr_le_eq(&model.bonds[index], BT_ADDR_LE_ANY);
+}
+
+static void model_clear(int index) {
+    bt_addr_le_copy(&model.bonds[index], BT_ADDR_LE_ANY);
+    model.names[index][0] = '\0';
+}
+
+static const zmk_ble_management_Response *
+call(const zmk_ble_management_Request *req) {
+    static zmk_ble_management_Response resp;
+    zassert_ok(harness_call(req, &resp), "request encoding failed");
+    return &resp;
+}
+
+static bool expect_success(uint32_t seq, bool actual, bool expected) {
+    if (actual != expected) {
+        dump_history(seq);
+        TC_PRINT("expected success=%d, got %d\n", expected, actual);
+        return false;
+    }
+    return true;
+}
+
+static bool check_profiles(uint32_t seq) {
+    zmk_ble_management_Request req = zmk_ble_management_Request_init_zero;
+    req.which_request_type = zmk_ble_management_Request_get_profiles_tag;
+    const zmk_ble_management_Response *resp = call(&req);
+
+    zassert_equal(resp->which_response_type,
+                  zmk_ble_management_Response_get_profiles_tag);
+    const zmk_ble_management_GetProfilesResponse *profiles =
+        &resp->response_type.get_profiles;
+    zassert_equal(profiles->profiles_count, ZMK_BLE_PROFILE_COUNT);
+
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        const zmk_ble_management_ProfileInfo *info = &profiles->profiles[i];
+        // The address field only fits the bare address, without its type
+        char addr[BT_ADDR_STR_LEN] = "";
+        if (!model_is_open(i)) {
+            bt_addr_to_str(&model.bonds[i].a, addr, sizeof(addr));
+        }
+
+        if (info->is_active != (i == model.active) ||
+            info->is_open != model_is_open(i) || strcmp(info->address, addr) ||
+            strcmp(info->name, model.names[i])) {
+            dump_history(seq);
+            TC_PRINT("profile %d: got active=%d open=%d addr='%s' name='%s', "
+                     "expected active=%d open=%d addr='%s' name='%s'\n",
+                     i, info->is_active, info->is_open, info->address,
+                     info->name, i == model.active, model_is_open(i), addr,
+                     model.names[i]);
+            return false;
+        }
+    }
+
+    if (fake_settings_count() > ZMK_BLE_PROFILE_COUNT) {
+        dump_history(seq);
+        TC_PRINT("%zu settings records for %d profiles\n",
+                 fake_settings_count(), ZMK_BLE_PROFILE_COUNT);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Apply one random step to the handler and the model.
+ * Index ZMK_BLE_PROFILE_COUNT is deliberately out of range.
+ */
+static bool run_step(uint32_t seq) {
+    zmk_ble_management_Request req = zmk_ble_management_Request_init_zero;
+    const zmk_ble_management_Response *resp;
+    uint32_t index = harness_rng_below(ZMK_BLE_PROFILE_COUNT + 1);
+    bool valid     = index < ZMK_BLE_PROFILE_COUNT;
+
+    enum model_op op =
+        harness_pick_weighted(op_weights, ARRAY_SIZE(op_weights));
+
+    switch (op) {
+        case OP_PAIR: {
+            bt_addr_le_t addr;
+            harness_random_addr(&addr);
+            record("pair on %d", model.active);
+            // A name set while the profile was open goes to the new host
+            if (fake_zmk_pair(&addr) == 0) {
+                harness_pairing_complete();
+                bt_addr_le_copy(&model.bonds[model.active], &addr);
+            }
+            return true;
+        }
+        case OP_RENAME: {
+            req.which_request_type =
+                zmk_ble_management_Request_set_profile_name_tag;
+            req.request_type.set_profile_name.index = index;
+            harness_random_name(req.request_type.set_profile_name.name,
+                                NAME_LEN);
+            record("rename %u '%s'", index,
+                   req.request_type.set_profile_name.name);
+            // Open profiles keep the name until a host bonds to them
+            resp          = call(&req);
+            bool expected = valid;
+            if (expected) {
+                strcpy(model.names[index],
+                       req.request_type.set_profile_name.name);
+            }
+            return expect_success(
+                seq, resp->response_type.set_profile_name.success, expected);
+        }
+        case OP_SWITCH:
+            req.which_request_type =
+                zmk_ble_management_Request_switch_profile_tag;
+            req.request_type.switch_profile.index = index;
+            record("switch %u", index);
+            resp = call(&req);
+            if (valid) {
+                model.active = index;
+            }
+            return expect_success(
+                seq, resp->response_type.switch_profile.success, valid);
+        case OP_UNPAIR:
+            req.which_request_type =
+                zmk_ble_management_Request_unpair_profile_tag;
+            req.request_type.unpair_profile.index = index;
+            record("unpair %u", index);
+            resp = call(&req);
+            if (valid) {
+                model_clear(index);
+            }
+            return expect_success(
+                seq, resp->response_type.unpair_profile.success, valid);
+        case OP_KEYMAP_CLEAR:
+            // &bt BT_CLR bypasses the handler
+            record("keymap clear on %d", model.active);
+            zmk_ble_clear_bonds();
+            if (!model_is_open(model.active)) {
+                model_clear(model.active);
+            }
+            return true;
+        case OP_FORGET_SPLIT:
+            req.which_request_type =
+                zmk_ble_management_Request_forget_split_bond_tag;
+            record("forget split bond");
+            resp = call(&req);
+            for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+                model_clear(i);
+            }
+            return expect_success(
+                seq, resp->response_type.forget_split_bond.success, true);
+        case OP_REBOOT:
+            record("reboot");
+            harness_reboot();
+            return true;
+    }
+    return true;
+}
+
+static uint64_t now_us(void) { return harness_now_ns() / NSEC_PER_USEC; }
+
+static void reset_all(void) {
+    fake_zmk_reset();
+    fake_settings_clear();
+    harness_reboot();
+
+    for (int i = 0; i < ZMK_BLE_PROFILE_COUNT; i++) {
+        model_clear(i);
+    }
+    model.active  = 0;
+    history_count = 0;
+}
+
+ZTEST(profile_model, test_random_sequences) {
+    uint64_t total_us = 0;
+    uint64_t max_us   = 0;
+
+    for (uint32_t seq = 0; seq < SEQUENCES; seq++) {
+        reset_all();
+        harness_rng_seed(seq + 1);
+
+        uint64_t start = now_us();
+        for (uint32_t step = 0; step < STEPS_PER_SEQUENCE; step++) {
+            zassert_true(run_step(seq) && check_profiles(seq),
+                         "sequence %u diverged from the model", seq);
+        }
+        uint64_t elapsed = now_us() - start;
+
+        total_us += elapsed;
+        max_us = MAX(max_us, elapsed);
+        TC_PRINT("sequence %u: %u steps in %llu us\n", seq, STEPS_PER_SEQUENCE,
+                 (unsigned long long)elapsed);
+        zassert_true(elapsed < SEQUENCE_BUDGET_US,
+                     "sequence %u took %llu us (budget %u us)", seq,
+                     (unsigned long long)elapsed, SEQUENCE_BUDGET_US);
+    }
+
+    TC_PRINT("%u sequences: mean %llu us, max %llu us\n", SEQUENCES,
+             (unsigned long long)(total_us / SEQUENCES),
+             (unsigned long long)max_us);
+}
+
+static void *profile_model_setup(void) {
+    settings_subsys_init();
+    return NULL;
+}
+
+ZTEST_SUITE(profile_model, NULL, profile_model_setup, NULL, NULL, NULL);
@@ -0,0 +1,272 @@
+/**
+ * Soak test of the management path
+ *
+ * Hundreds of thousands of mixed RPCs, profile switches, host pairings and
+ * occasional reboots are pushed through the handler in fixed-size windows.
+ * At the end of every window the handler latency (median and p99), the
+ * stack and heap watermarks and the size of the settings store are sampled.
+ * The first windows warm up and set the baseline; the run fails if the last
+ * windows drift beyond the thresholds below, which is what months of uptime
+ * with a slow leak or an ever-growing lookup would look like.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/ztest.h>
+
+#include "fakes.h"
+#include "harness.h"
+
+#define WINDOWS          20
+#define OPS_PER_WINDOW   20000
+#define WARMUP_WINDOWS   1
+#define BASELINE_WINDOWS 3
+#define TAIL_WINDOWS     3
+#define SEED             0x50a4
+
+// Thresholds of the tail against the baseline. Latency gets an absolute
+// slack on top because host timer resolution dominates at these scales.
+#define LATENCY_DRIFT_PCT     50
+#define LATENCY_P99_DRIFT_PCT 100
+#define LATENCY_SLACK_NS      1000
+#define STACK_DRIFT_BYTES     256
+#define SETTINGS_DRIFT_PCT    25
+
+BUILD_ASSERT(WARMUP_WINDOWS + BASELINE_WINDOWS + TAIL_WINDOWS <= WINDOWS);
+
+// The handler must not allocate; a change that makes it allocate shows up here
+extern struct k_heap _system_heap;
+
+struct window_sample {
+    uint32_t median_ns;
+    uint32_t p99_ns;
+    size_t stack_unused;
+    size_t heap_allocated;
+    size_t heap_max_allocated;
+    size_t settings_bytes;
+    size_t settings_count;
+};
+
+enum soak_op {
+    SOAK_GET_PROFILES,
+    SOAK_SET_PROFILE_NAME,
+    SOAK_SWITCH_PROFILE,
+    SOAK_UNPAIR_PROFILE,
+    SOAK_SET_OUTPUT_PRIORITY,
+    SOAK_STATUS_QUERY,
+    SOAK_FORGET_SPLIT_BOND,
+    SOAK_HOST_PAIR,
+    SOAK_REBOOT,
+};
+
+static const uint16_t op_weights[] = {
+    [SOAK_GET_PROFILES] = 200,       [SOAK_SET_PROFILE_NAME] = 150,
+    [SOAK_SWITCH_PROFILE] = 200,     [SOAK_UNPAIR_PROFILE] = 30,
+    [SOAK_SET_OUTPUT_PRIORITY] = 50, [SOAK_STATUS_QUERY] = 300,
+    [SOAK_FORGET_SPLIT_BOND] = 2,    [SOAK_HOST_PAIR] = 60,
+    [SOAK_REBOOT] = 8,
+};
+
+// Read-only requests; most report -ENOTSUP here, which is still a full
+// decode, dispatch and encode
+static const pb_size_t status_tags[] = {
+    zmk_ble_management_Request_get_split_info_tag,
+    zmk_ble_management_Request_get_output_priority_tag,
+    zmk_ble_management_Request_get_conn_scheduler_tag,
+    zmk_ble_management_Request_get_report_stats_tag,
+    zmk_ble_management_Request_get_buffer_usage_tag,
+    zmk_ble_management_Request_get_failover_stats_tag,
+    zmk_ble_management_Request_get_supervision_tag,
+    zmk_ble_management_Request_get_param_update_stats_tag,
+    zmk_ble_management_Request_get_wake_latency_tag,
+    zmk_ble_management_Request_get_boot_profile_tag,
+    zmk_ble_management_Request_get_settings_wear_tag,
+    zmk_ble_management_Request_get_split_link_tag,
+    zmk_ble_management_Request_get_peripheral_status_tag,
+    zmk_ble_management_Request_get_split_reconnect_tag,
+    zmk_ble_management_Request_get_metrics_schema_tag,
+    zmk_ble_management_Request_get_metrics_tag,
+};
+
+static uint32_t latencies[OPS_PER_WINDOW];
+static struct window_sample samples[WINDOWS];
+
+/**
+ * Run one operation; returns the handler latency of RPCs, 0 otherwise
+ */
+static uint32_t run_op(void) {
+    zmk_ble_management_Request req = zmk_ble_management_Request_init_zero;
+    static zmk_ble_management_Response resp;
+    uint8_t index = harness_rng_below(ZMK_BLE_PROFILE_COUNT);
+
+    enum soak_op op =
+        harness_pick_weighted(op_weights, ARRAY_SIZE(op_weights));
+
+    switch (op) {
+        case SOAK_GET_PROFILES:
+            req.which_request_type =
+                zmk_ble_management_Request_get_profiles_tag;
+            break;
+        case SOAK_SET_PROFILE_NAME:
+            req.which_request_type =
+                zmk_ble_management_Request_set_profile_name_tag;
+            req.request_type.set_profile_name.index = index;
+            harness_random_name(req.request_type.set_profile_name.name,
+                                sizeof(req.request_type.set_profile_name.name));
+            break;
+        case SOAK_SWITCH_PROFILE:
+            req.which_request_type =
+                zmk_ble_management_Request_switch_profile_tag;
+            req.request_type.switch_profile.index = index;
+            break;
+        case SOAK_UNPAIR_PROFILE:
+            req.which_request_type =
+                zmk_ble_management_Request_unpair_profile_tag;
+            req.request_type.unpair_profile.index = index;
+            break;
+        case SOAK_SET_OUTPUT_PRIORITY:
+            req.which_request_type =
+                zmk_ble_management_Request_set_output_priority_tag;
+            req.request_type.set_output_priority.priority =
+                harness_rng_below(2)
+                    ? zmk_ble_management_OutputPriority_OUTPUT_PRIORITY_BLE
+                    : zmk_ble_management_OutputPriority_OUTPUT_PRIORITY_USB;
+            break;
+        case SOAK_STATUS_QUERY:
+            req.which_request_type =
+                status_tags[harness_rng_below(ARRAY_SIZE(status_tags))];
+            break;
+        case SOAK_FORGET_SPLIT_BOND:
+            req.which_request_type =
+                zmk_ble_management_Request_forget_split_bond_tag;
+            break;
+        case SOAK_HOST_PAIR: {
+            bt_addr_le_t addr;
+            harness_random_addr(&addr);
+            if (fake_zmk_pair(&addr) == 0) {
+                harness_pairing_complete();
+            }
+            return 0;
+        }
+        case SOAK_REBOOT:
+            harness_reboot();
+            return 0;
+    }
+
+    uint64_t start = harness_now_ns();
+    zassert_ok(harness_call(&req, &resp), "request encoding failed");
+    uint64_t elapsed = harness_now_ns() - start;
+
+    zassert_not_equal(resp.which_response_type, 0, "no response for tag %u",
+                      req.which_request_type);
+    return CLAMP(elapsed, 1, UINT32_MAX);
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void take_sample(struct window_sample *sample, size_t rpcs) {
+    qsort(latencies, rpcs, sizeof(latencies[0]), compare_u32);
+    sample->median_ns = latencies[rpcs / 2];
+    sample->p99_ns    = latencies[rpcs * 99 / 100];
+
+    zassert_ok(k_thread_stack_space_get(k_current_get(),
+                                        &sample->stack_unused));
+
+    struct sys_memory_stats heap;
+    zassert_ok(sys_heap_runtime_stats_get(&_system_heap.heap, &heap));
+    sample->heap_allocated     = heap.allocated_bytes;
+    sample->heap_max_allocated = heap.max_allocated_bytes;
+
+    sample->settings_bytes = fake_settings_bytes();
+    sample->settings_count = fake_settings_count();
+}
+
+static bool drifted(uint32_t tail, uint32_t baseline, uint32_t pct) {
+    return tail > (uint64_t)baseline * (100 + pct) / 100 + LATENCY_SLACK_NS;
+}
+
+ZTEST(handler_soak, test_soak) {
+    fake_zmk_reset();
+    fake_settings_clear();
+    harness_reboot();
+    harness_rng_seed(SEED);
+
+    for (int w = 0; w < WINDOWS; w++) {
+        size_t rpcs = 0;
+        for (int i = 0; i < OPS_PER_WINDOW; i++) {
+            uint32_t latency = run_op();
+            if (latency) {
+                latencies[rpcs++] = latency;
+            }
+        }
+        zassert_true(rpcs > 0);
+
+        struct window_sample *sample = &samples[w];
+        take_sample(sample, rpcs);
+        TC_PRINT("window %d: %zu rpcs, median %u ns, p99 %u ns, stack unused "
+                 "%zu, heap %zu (peak %zu), settings %zu records %zu bytes\n",
+                 w, rpcs, sample->median_ns, sample->p99_ns,
+                 sample->stack_unused, sample->heap_allocated,
+                 sample->heap_max_allocated, sample->settings_count,
+                 sample->settings_bytes);
+    }
+
+    // Latency compares the slowest baseline window against the fastest tail
+    // window, so a single window descheduled by a busy host cannot fail it
+    struct window_sample base = {.stack_unused = SIZE_MAX};
+    for (int w = WARMUP_WINDOWS; w < WARMUP_WINDOWS + BASELINE_WINDOWS; w++) {
+        base.median_ns      = MAX(base.median_ns, samples[w].median_ns);
+        base.p99_ns         = MAX(base.p99_ns, samples[w].p99_ns);
+        base.stack_unused   = MIN(base.stack_unused, samples[w].stack_unused);
+        base.settings_bytes = MAX(base.settings_bytes,
+                                  samples[w].settings_bytes);
+    }
+    base.heap_allocated     = samples[0].heap_allocated;
+    base.heap_max_allocated = samples[WARMUP_WINDOWS + BASELINE_WINDOWS - 1]
+                                  .heap_max_allocated;
+
+    struct window_sample tail = samples[WINDOWS - 1];
+    for (int w = WINDOWS - TAIL_WINDOWS; w < WINDOWS; w++) {
+        tail.median_ns      = MIN(tail.median_ns, samples[w].median_ns);
+        tail.p99_ns         = MIN(tail.p99_ns, samples[w].p99_ns);
+        tail.settings_bytes = MAX(tail.settings_bytes,
+                                  samples[w].settings_bytes);
+    }
+
+    zassert_false(drifted(tail.median_ns, base.median_ns, LATENCY_DRIFT_PCT),
+                  "median latency drifted from %u ns to %u ns",
+                  base.median_ns, tail.median_ns);
+    zassert_false(drifted(tail.p99_ns, base.p99_ns, LATENCY_P99_DRIFT_PCT),
+                  "p99 latency drifted from %u ns to %u ns", base.p99_ns,
+                  tail.p99_ns);
+    zassert_true(tail.stack_unused + STACK_DRIFT_BYTES >= base.stack_unused,
+                 "stack headroom shrank from %zu to %zu bytes",
+                 base.stack_unused, tail.stack_unused);
+    zassert_equal(tail.heap_allocated, base.heap_allocated,
+                  "heap grew from %zu to %zu bytes", base.heap_allocated,
+                  tail.heap_allocated);
+    zassert_equal(tail.heap_max_allocated, base.heap_max_allocated,
+                  "heap peak grew from %zu to %zu bytes",
+                  base.heap_max_allocated, tail.heap_max_allocated);
+    zassert_true(tail.settings_bytes <= base.settings_bytes *
+                                            (100 + SETTINGS_DRIFT_PCT) / 100,
+                 "settings grew from %zu to %zu bytes", base.settings_bytes,
+                 tail.settings_bytes);
+    zassert_true(tail.settings_count <= ZMK_BLE_PROFILE_COUNT,
+                 "%zu settings records for %d profiles", tail.settings_count,
+                 ZMK_BLE_PROFILE_COUNT);
+}
+
+static void *handler_soak_setup(void) {
+    settings_subsys_init();
+    return NULL;
+}
+
+ZTEST_SUITE(handler_soak, NULL, handler_soak_setup, NULL, NULL, NULL);
@@ -0,0 +1,40 @@
+/**
+ * A way of persisting profile names under the ble_mgmt settings subtree
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <zephyr/bluetooth/addr.h>
+#include <zephyr/settings/settings.h>
+
+// ProfileInfo.name, terminating NUL included
+#define BENCH_NAME_LEN 33
+
+struct bench_record {
+    bt_addr_le_t addr;
+    char name[BENCH_NAME_LEN];
+};
+
+struct bench_layout {
+    const char *name;
+
+    /**
+     * Persist records[index] after it was added or renamed; records[0] up to
+     * records[count - 1] hold every current name.
+     */
+    int (*save)(const struct bench_record *records, size_t count,
+                size_t index);
+
+    /**
+     * settings h_set of the "ble_mgmt" subtree; every name found is passed
+     * to bench_loaded_add().
+     */
+    int (*set)(const char *key, size_t len, settings_read_cb read_cb,
+               void *cb_arg);
+};
+
+// Provided by the layout built in
+extern const struct bench_layout bench_layout;
+
+void bench_loaded_add(const bt_addr_le_t *addr, const char *name);
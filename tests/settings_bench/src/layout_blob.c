@@ -0,0 +1,46 @@
+/**
+ * Candidate layout: every name in a single "ble_mgmt/names" record, which
+ * is rewritten as a whole on every change.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "layout.h"
+
+#define MAX_RECORDS 64
+
+static int blob_save(const struct bench_record *records, size_t count,
+                     size_t index) {
+    return settings_save_one("ble_mgmt/names", records,
+                             count * sizeof(records[0]));
+}
+
+static int blob_set(const char *key, size_t len, settings_read_cb read_cb,
+                    void *cb_arg) {
+    static struct bench_record records[MAX_RECORDS];
+    const char *next;
+    if (!settings_name_steq(key, "names", &next) || next) {
+        return -ENOENT;
+    }
+
+    if (len % sizeof(records[0]) || len > sizeof(records)) {
+        return -EINVAL;
+    }
+    int rc = read_cb(cb_arg, records, len);
+    if (rc < 0) {
+        return rc;
+    }
+
+    for (size_t i = 0; i < len / sizeof(records[0]); i++) {
+        records[i].name[BENCH_NAME_LEN - 1] = '\0';
+        bench_loaded_add(&records[i].addr, records[i].name);
+    }
+    return 0;
+}
+
+const struct bench_layout bench_layout = {
+    .name = "blob",
+    .save = blob_save,
+    .set  = blob_set,
+};
@@ -0,0 +1,62 @@
+/**
+ * Current layout of the Studio handler: one "ble_mgmt/name/<addr>" record
+ * per name, holding the NUL terminated name. The address type is not part
+ * of the key.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "layout.h"
+
+#define KEY_PREFIX "ble_mgmt/name/"
+
+static int string_key_save(const struct bench_record *records, size_t count,
+                           size_t index) {
+    char addr_str[BT_ADDR_STR_LEN];
+    char key[64];
+    bt_addr_to_str(&records[index].addr.a, addr_str, sizeof(addr_str));
+    snprintf(key, sizeof(key), KEY_PREFIX "%s", addr_str);
+
+    return settings_save_one(key, records[index].name,
+                             strlen(records[index].name) + 1);
+}
+
+static int string_key_set(const char *key, size_t len,
+                          settings_read_cb read_cb, void *cb_arg) {
+    const char *addr_str;
+    if (!settings_name_steq(key, "name", &addr_str) || !addr_str) {
+        return -ENOENT;
+    }
+
+    // bt_addr_le_from_str() needs the Bluetooth stack; parse it here
+    unsigned int b[6];
+    if (sscanf(addr_str, "%2x:%2x:%2x:%2x:%2x:%2x", &b[0], &b[1], &b[2],
+               &b[3], &b[4], &b[5]) != 6) {
+        return -EINVAL;
+    }
+    bt_addr_le_t addr = {.type = BT_ADDR_LE_PUBLIC};
+    for (int i = 0; i < 6; i++) {
+        addr.a.val[5 - i] = b[i];
+    }
+
+    char name[BENCH_NAME_LEN] = "";
+    if (len > sizeof(name)) {
+        return -EINVAL;
+    }
+    int rc = read_cb(cb_arg, name, len);
+    if (rc < 0) {
+        return rc;
+    }
+    name[sizeof(name) - 1] = '\0';
+
+    bench_loaded_add(&addr, name);
+    return 0;
+}
+
+const struct bench_layout bench_layout = {
+    .name = "string_key",
+    .save = string_key_save,
+    .set  = string_key_set,
+};
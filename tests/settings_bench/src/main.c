@@ -0,0 +1,201 @@
+/**
+ * Settings backend benchmark for profile name persistence
+ *
+ * Runs against the flash simulator with the backend of the build (nvs.conf,
+ * fcb.conf or fs.conf) and the record layout chosen in Kconfig. Names are
+ * added one by one; at every checkpoint the save latency since the previous
+ * checkpoint, the time to load the ble_mgmt subtree and the storage
+ * footprint are reported. Finally every name is renamed a few times, which
+ * is where log structured backends start to collect garbage.
+ *
+ * Latencies are host time and only comparable between runs on one machine.
+ * The footprint counts programmed (non-erased) bytes of the partition, so it
+ * includes stale records and backend metadata. Results are printed as
+ *   BENCH backend=<b> layout=<l> phase=<insert|rename> records=<n>
+ *         saves=<n> save_mean_ns=<n> save_max_ns=<n> load_ns=<n>
+ *         flash_bytes=<n>
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/ztest.h>
+
+#include "layout.h"
+
+#define MAX_RECORDS        40
+#define RENAMES_PER_RECORD 8
+#define ERASED_VALUE       0xff
+
+static const size_t checkpoints[] = {1, 5, 10, 20, MAX_RECORDS};
+
+#if IS_ENABLED(CONFIG_SETTINGS_NVS)
+#define BACKEND "nvs"
+#elif IS_ENABLED(CONFIG_SETTINGS_FCB)
+#define BACKEND "fcb"
+#elif IS_ENABLED(CONFIG_SETTINGS_FS)
+#define BACKEND "fs"
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+FS_FSTAB_DECLARE_ENTRY(DT_NODELABEL(lfs));
+#else
+#error "Build with one of nvs.conf, fcb.conf or fs.conf"
+#endif
+
+struct save_stats {
+    uint32_t saves;
+    uint64_t total_ns;
+    uint64_t max_ns;
+};
+
+static struct bench_record records[MAX_RECORDS];
+static struct bench_record loaded[MAX_RECORDS];
+static size_t loaded_count;
+static bool loaded_overflow;
+
+void bench_loaded_add(const bt_addr_le_t *addr, const char *name) {
+    if (loaded_count == ARRAY_SIZE(loaded)) {
+        loaded_overflow = true;
+        return;
+    }
+    bt_addr_le_copy(&loaded[loaded_count].addr, addr);
+    strncpy(loaded[loaded_count].name, name, BENCH_NAME_LEN - 1);
+    loaded_count++;
+}
+
+static int bench_settings_set(const char *key, size_t len,
+                              settings_read_cb read_cb, void *cb_arg) {
+    return bench_layout.set(key, len, read_cb, cb_arg);
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench_names, "ble_mgmt", NULL,
+                               bench_settings_set, NULL, NULL);
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static void make_record(size_t index, uint32_t revision) {
+    // Public addresses: the string key layout does not keep the type
+    struct bench_record *record = &records[index];
+    record->addr.type           = BT_ADDR_LE_PUBLIC;
+    for (int i = 0; i < 6; i++) {
+        record->addr.a.val[i] = 0xc0 + index + i;
+    }
+
+    // Realistic lengths, varying with the revision
+    memset(record->name, 0, sizeof(record->name));
+    snprintf(record->name, sizeof(record->name), "Host %02zu rev %u%.*s",
+             index, revision, (int)((index + revision) % 12),
+             "------------");
+}
+
+static void timed_save(struct save_stats *stats, size_t count, size_t index) {
+    uint64_t start = now_ns();
+    int rc         = bench_layout.save(records, count, index);
+    uint64_t took  = now_ns() - start;
+
+    zassert_ok(rc, "save of record %zu failed: %d", index, rc);
+    stats->saves++;
+    stats->total_ns += took;
+    stats->max_ns = MAX(stats->max_ns, took);
+}
+
+static uint64_t timed_load(size_t expected) {
+    loaded_count    = 0;
+    loaded_overflow = false;
+
+    uint64_t start = now_ns();
+    zassert_ok(settings_load_subtree("ble_mgmt"));
+    uint64_t took = now_ns() - start;
+
+    zassert_false(loaded_overflow);
+    zassert_equal(loaded_count, expected, "loaded %zu of %zu names",
+                  loaded_count, expected);
+    for (size_t i = 0; i < expected; i++) {
+        bool found = false;
+        for (size_t j = 0; j < loaded_count && !found; j++) {
+            found = bt_addr_le_eq(&loaded[j].addr, &records[i].addr) &&
+                    !strcmp(loaded[j].name, records[i].name);
+        }
+        zassert_true(found, "name %zu '%s' not loaded", i, records[i].name);
+    }
+    return took;
+}
+
+static size_t flash_footprint(void) {
+    const struct flash_area *fa;
+    zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa));
+
+    uint8_t buf[256];
+    size_t programmed = 0;
+    for (off_t off = 0; off < fa->fa_size; off += sizeof(buf)) {
+        size_t len = MIN(sizeof(buf), fa->fa_size - off);
+        zassert_ok(flash_area_read(fa, off, buf, len));
+        for (size_t i = 0; i < len; i++) {
+            programmed += buf[i] != ERASED_VALUE;
+        }
+    }
+
+    flash_area_close(fa);
+    return programmed;
+}
+
+static void report(const char *phase, size_t count,
+                   const struct save_stats *stats, uint64_t load_ns) {
+    TC_PRINT("BENCH backend=%s layout=%s phase=%s records=%zu saves=%u "
+             "save_mean_ns=%llu save_max_ns=%llu load_ns=%llu "
+             "flash_bytes=%zu\n",
+             BACKEND, bench_layout.name, phase, count, stats->saves,
+             (unsigned long long)(stats->saves ? stats->total_ns / stats->saves
+                                               : 0),
+             (unsigned long long)stats->max_ns, (unsigned long long)load_ns,
+             flash_footprint());
+}
+
+ZTEST(settings_bench, test_names) {
+    size_t count = 0;
+
+    for (size_t c = 0; c < ARRAY_SIZE(checkpoints); c++) {
+        struct save_stats stats = {0};
+        for (; count < checkpoints[c]; count++) {
+            make_record(count, 0);
+            timed_save(&stats, count + 1, count);
+        }
+        report("insert", count, &stats, timed_load(count));
+    }
+
+    struct save_stats stats = {0};
+    for (uint32_t rev = 1; rev <= RENAMES_PER_RECORD; rev++) {
+        for (size_t i = 0; i < count; i++) {
+            make_record(i, rev);
+            timed_save(&stats, count, i);
+        }
+    }
+    report("rename", count, &stats, timed_load(count));
+}
+
+/**
+ * Start from an erased partition so every run measures the same history.
+ * This has to happen before the backend is initialized.
+ */
+static void *settings_bench_setup(void) {
+    const struct flash_area *fa;
+    zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa));
+    zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+    flash_area_close(fa);
+
+#if IS_ENABLED(CONFIG_SETTINGS_FS)
+    zassert_ok(fs_mount(&FS_FSTAB_ENTRY(DT_NODELABEL(lfs))));
+#endif
+
+    zassert_ok(settings_subsys_init());
+    return NULL;
+}
+
+ZTEST_SUITE(settings_bench, NULL, settings_bench_setup, NULL, NULL, NULL);
@@ -1,7 +1,8 @@
 /**
  * OutputPriorityManager Component
  *
- * Manages output priority (transport) selection between USB and BLE.
+ * Manages output priority (transport) selection between USB and BLE, and shows
+ * HID report delivery and failover statistics when the firmware collects them.
  */
 
 import { useContext, useState, useEffect, useCallback } from "react";
@@ -14,6 +15,9 @@ import {
   Request,
   Response,
   OutputPriority,
+  GetFailoverStatsResponse,
+  GetReportStatsResponse,
+  ReportStats,
 } from "../proto/zmk/ble_management/ble_management";
 import "./OutputPriorityManager.css";
 
@@ -22,11 +26,58 @@ export function OutputPriorityManager() {
   const [currentPriority, setCurrentPriority] = useState<OutputPriority | null>(
     null
   );
+  const [reportStats, setReportStats] = useState<GetReportStatsResponse | null>(
+    null
+  );
+  const [failoverStats, setFailoverStats] =
+    useState<GetFailoverStatsResponse | null>(null);
   const [isLoading, setIsLoading] = useState(false);
   const [error, setError] = useState<string | null>(null);
 
   const subsystem = zmkApp?.findSubsystem(SUBSYSTEM_IDENTIFIER);
 
+  // Load report and failover statistics; hidden when the firmware does not
+  // collect them
+  const loadReportStats = useCallback(
+    async (reset: boolean = false) => {
+      if (!zmkApp?.state.connection || !subsystem) return;
+
+      try {
+        const service = new ZMKCustomSubsystem(
+          zmkApp.state.connection,
+          subsystem.index
+        );
+
+        const request = Request.create({
+          getReportStats: { reset },
+        });
+
+        const payload = Request.encode(request).finish();
+        const responsePayload = await service.callRPC(payload);
+
+        if (responsePayload) {
+          const resp = Response.decode(responsePayload);
+          setReportStats(resp.getReportStats ?? null);
+        }
+
+        const failoverPayload = await service.callRPC(
+          Request.encode(Request.create({ getFailoverStats: {} })).finish()
+        );
+
+        if (failoverPayload) {
+          const resp = Response.decode(failoverPayload);
+          setFailoverStats(resp.getFailoverStats ?? null);
+        }
+      } catch (err) {
+        console.error("Failed to load report statistics:", err);
+        setReportStats(null);
+        setFailoverStats(null);
+      }
+    },
+    // eslint-disable-next-line react-hooks/exhaustive-deps
+    [zmkApp?.state.connection, subsystem?.index]
+  );
+
   // Load current output priority on mount
   const loadOutputPriority = useCallback(
     async () => {
@@ -71,10 +122,15 @@ export function OutputPriorityManager() {
 
   useEffect(() => {
     if (subsystem && zmkApp?.state.connection) {
-      loadOutputPriority();
+      loadOutputPriority().then(() => loadReportStats());
     }
     // eslint-disable-next-line react-hooks/exhaustive-deps
-  }, [subsystem?.index, zmkApp?.state.connection, loadOutputPriority]);
+  }, [
+    subsystem?.index,
+    zmkApp?.state.connection,
+    loadOutputPriority,
+    loadReportStats,
+  ]);
 
   const setOutputPriority = async (priority: OutputPriority) => {
     if (!zmkApp?.state.connection || !subsystem) return;
@@ -122,6 +178,16 @@ export function OutputPriorityManager() {
   const priorityName =
     currentPriority === OutputPriority.OUTPUT_PRIORITY_USB ? "USB" : "BLE";
 
+  const renderStatsRow = (label: string, stats: ReportStats | undefined) => (
+    <tr key={label}>
+      <td>{label}</td>
+      <td>{stats?.sent ?? 0}</td>
+      <td>{stats?.failed ?? 0}</td>
+      <td>{stats?.notifyFailed ?? 0}</td>
+      <td>{stats?.noBuffer ?? 0}</td>
+    </tr>
+  );
+
   return (
     <section className="card output-priority-manager">
       <h2>🔌 Output Priority</h2>
@@ -195,9 +261,60 @@ export function OutputPriorityManager() {
         </div>
       )}
 
+      {failoverStats?.stats && (
+        <div className="report-stats">
+          <h3>🔀 Link Failover</h3>
+          <div className="info-item">
+            <strong>Active Transport:</strong>{" "}
+            {failoverStats.active === OutputPriority.OUTPUT_PRIORITY_USB
+              ? "USB"
+              : "BLE"}
+          </div>
+          <div className="info-item">
+            <strong>Failovers / Fail-backs:</strong>{" "}
+            {failoverStats.stats.failovers} / {failoverStats.stats.failbacks}
+          </div>
+          <div className="info-item">
+            <strong>Gaps without link:</strong> {failoverStats.stats.gaps}{" "}
+            (last {failoverStats.stats.lastGapMs} ms, max{" "}
+            {failoverStats.stats.maxGapMs} ms)
+          </div>
+        </div>
+      )}
+
+      {reportStats && (
+        <div className="report-stats">
+          <h3>📊 Report Delivery</h3>
+          <table className="report-stats-table">
+            <thead>
+              <tr>
+                <th>Transport</th>
+                <th>Sent</th>
+                <th>Failed</th>
+                <th>Notify Failed</th>
+                <th>No Buffer</th>
+              </tr>
+            </thead>
+            <tbody>
+              {renderStatsRow("USB", reportStats.usb)}
+              {reportStats.ble.map((entry) =>
+                renderStatsRow(`BLE ${entry.index}`, entry.stats)
+              )}
+            </tbody>
+          </table>
+          <button
+            className="btn btn-secondary"
+            onClick={() => loadReportStats(true)}
+            disabled={isLoading}
+          >
+            🧹 Reset Counters
+          </button>
+        </div>
+      )}
+
       <button
         className="btn btn-secondary"
-        onClick={loadOutputPriority}
+        onClick={() => loadOutputPriority().then(() => loadReportStats())}
         disabled={isLoading}
       >
         🔄 Refresh
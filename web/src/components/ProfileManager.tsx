@@ -259,94 +259,80 @@ export function ProfileManager() {
               {profile.isOpen && <span className="badge empty">Empty</span>}
             </div>
 
-            {!profile.isOpen ? (
-              <>
-                <div className="profile-info">
-                  {editingIndex === profile.index ? (
-                    <div className="edit-name">
-                      <input
-                        type="text"
-                        value={editName}
-                        onChange={(e) => setEditName(e.target.value)}
-                        placeholder="Device name"
-                        maxLength={31}
-                      />
-                      <button
-                        className="btn btn-sm btn-primary"
-                        onClick={() => saveProfileName(profile.index, editName)}
-                        disabled={isLoading}
-                      >
-                        ✓ Save
-                      </button>
-                      <button
-                        className="btn btn-sm btn-secondary"
-                        onClick={cancelEditing}
-                        disabled={isLoading}
-                      >
-                        ✗ Cancel
-                      </button>
-                    </div>
-                  ) : (
-                    <>
-                      <p className="profile-name">
-                        <strong>Name:</strong>{" "}
-                        {profile.name || (
-                          <em className="text-muted">Not named</em>
-                        )}
-                        <button
-                          className="btn btn-link"
-                          onClick={() =>
-                            startEditing(profile.index, profile.name)
-                          }
-                          disabled={isLoading}
-                          title="Edit name"
-                        >
-                          ✏️
-                        </button>
-                      </p>
-                      <p className="profile-address">
-                        <strong>Address:</strong>{" "}
-                        <code>{profile.address || "N/A"}</code>
-                      </p>
-                    </>
-                  )}
-                </div>
-
-                <div className="profile-actions">
-                  {!profile.isActive && (
-                    <button
-                      className="btn btn-primary"
-                      onClick={() => switchProfile(profile.index)}
-                      disabled={isLoading}
-                    >
-                      Switch to this profile
-                    </button>
-                  )}
+            <div className="profile-info">
+              {editingIndex === profile.index ? (
+                <div className="edit-name">
+                  <input
+                    type="text"
+                    value={editName}
+                    onChange={(e) => setEditName(e.target.value)}
+                    placeholder="Device name"
+                    maxLength={31}
+                  />
                   <button
-                    className="btn btn-danger"
-                    onClick={() => unpairProfile(profile.index)}
+                    className="btn btn-sm btn-primary"
+                    onClick={() => saveProfileName(profile.index, editName)}
                     disabled={isLoading}
                   >
-                    🗑️ Unpair
+                    ✓ Save
+                  </button>
+                  <button
+                    className="btn btn-sm btn-secondary"
+                    onClick={cancelEditing}
+                    disabled={isLoading}
+                  >
+                    ✗ Cancel
                   </button>
                 </div>
-              </>
-            ) : (
-              <>
-                <p className="text-muted">No device paired in this slot.</p>
-                <div className="profile-actions">
-                  {!profile.isActive && (
+              ) : (
+                <>
+                  <p className="profile-name">
+                    <strong>Name:</strong>{" "}
+                    {profile.name || <em className="text-muted">Not named</em>}
                     <button
-                      className="btn btn-primary"
-                      onClick={() => switchProfile(profile.index)}
+                      className="btn btn-link"
+                      onClick={() => startEditing(profile.index, profile.name)}
                       disabled={isLoading}
+                      title="Edit name"
                     >
-                      Switch to this profile
+                      ✏️
                     </button>
+                  </p>
+                  {profile.isOpen ? (
+                    <p className="text-muted">
+                      No device paired in this slot. A name set now goes to the
+                      next host that pairs here.
+                    </p>
+                  ) : (
+                    <p className="profile-address">
+                      <strong>Address:</strong>{" "}
+                      <code>{profile.address || "N/A"}</code>
+                    </p>
                   )}
-                </div>
-              </>
-            )}
+                </>
+              )}
+            </div>
+
+            <div className="profile-actions">
+              {!profile.isActive && (
+                <button
+                  className="btn btn-primary"
+                  onClick={() => switchProfile(profile.index)}
+                  disabled={isLoading}
+                >
+                  Switch to this profile
+                </button>
+              )}
+              {!profile.isOpen && (
+                <button
+                  className="btn btn-danger"
+                  onClick={() => unpairProfile(profile.index)}
+                  disabled={isLoading}
+                >
+                  🗑️ Unpair
+                </button>
+              )}
+            </div>
           </div>
         ))}
       </div>
@@ -14,12 +14,37 @@ import {
   Request,
   Response,
   SplitInfo,
+  SplitPeripheralInfo,
 } from "../proto/zmk/ble_management/ble_management";
 import "./SplitManager.css";
 
+// Common HCI disconnect reasons seen on split links
+const DISCONNECT_REASONS: Record<number, string> = {
+  0x08: "Supervision timeout",
+  0x13: "Peripheral terminated",
+  0x16: "Central terminated",
+  0x22: "LL response timeout",
+  0x3d: "MIC failure",
+  0x3e: "Failed to establish",
+};
+
+function formatDisconnectReason(reason: number): string {
+  const hex = `0x${reason.toString(16).padStart(2, "0")}`;
+  return DISCONNECT_REASONS[reason]
+    ? `${DISCONNECT_REASONS[reason]} (${hex})`
+    : hex;
+}
+
+function formatDuration(seconds: number): string {
+  if (seconds < 60) return `${seconds}s`;
+  if (seconds < 3600) return `${Math.floor(seconds / 60)}m`;
+  return `${Math.floor(seconds / 3600)}h ${Math.floor((seconds % 3600) / 60)}m`;
+}
+
 export function SplitManager() {
   const zmkApp = useContext(ZMKAppContext);
   const [splitInfo, setSplitInfo] = useState<SplitInfo | null>(null);
+  const [peripherals, setPeripherals] = useState<SplitPeripheralInfo[]>([]);
   const [isLoading, setIsLoading] = useState(false);
   const [error, setError] = useState<string | null>(null);
 
@@ -50,6 +75,7 @@ export function SplitManager() {
           const resp = Response.decode(responsePayload);
           if (resp.getSplitInfo?.info) {
             setSplitInfo(resp.getSplitInfo.info);
+            setPeripherals(resp.getSplitInfo.peripherals);
           } else if (resp.error) {
             setError(resp.error.message);
           }
@@ -122,6 +148,51 @@ export function SplitManager() {
     }
   };
 
+  const forgetPeripheralBond = async (slot: number) => {
+    if (!zmkApp?.state.connection || !subsystem) return;
+    if (
+      !confirm(
+        `Make peripheral ${slot} forget its bond with this half? It will need to be re-paired.`
+      )
+    )
+      return;
+
+    setIsLoading(true);
+    setError(null);
+
+    try {
+      const service = new ZMKCustomSubsystem(
+        zmkApp.state.connection,
+        subsystem.index
+      );
+
+      const request = Request.create({
+        forgetPeripheralBond: { slot },
+      });
+
+      const payload = Request.encode(request).finish();
+      const responsePayload = await service.callRPC(payload);
+
+      if (responsePayload) {
+        const resp = Response.decode(responsePayload);
+        if (resp.forgetPeripheralBond?.success) {
+          await loadSplitInfo();
+        } else if (resp.error) {
+          setError(resp.error.message);
+        } else {
+          setError(`Peripheral ${slot} did not forget its bond`);
+        }
+      }
+    } catch (err) {
+      console.error("Failed to forget peripheral bond:", err);
+      setError(
+        `Failed to forget peripheral bond: ${err instanceof Error ? err.message : "Unknown error"}`
+      );
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
   if (!subsystem) {
     return null;
   }
@@ -151,7 +222,7 @@ export function SplitManager() {
               {splitInfo.isCentral ? "Central" : "Peripheral"}
             </div>
 
-            {splitInfo.isCentral && (
+            {splitInfo.isCentral && peripherals.length === 0 && (
               <div className="info-item">
                 <strong>Peripheral Status:</strong>{" "}
                 {splitInfo.peripheralConnected ? (
@@ -162,6 +233,65 @@ export function SplitManager() {
               </div>
             )}
 
+            {splitInfo.isCentral &&
+              peripherals.map((peripheral) => (
+                <div className="info-item" key={peripheral.slot}>
+                  <strong>Peripheral {peripheral.slot}:</strong>{" "}
+                  {peripheral.connected ? (
+                    <span className="status-connected">✓ Connected</span>
+                  ) : peripheral.bonded ? (
+                    <span className="status-disconnected">✗ Disconnected</span>
+                  ) : (
+                    <span className="status-not-bonded">✗ Not Bonded</span>
+                  )}
+                  {peripheral.address && (
+                    <div className="peripheral-detail">
+                      {peripheral.address}
+                    </div>
+                  )}
+                  {peripheral.connected && (
+                    <div className="peripheral-detail">
+                      Interval {(peripheral.interval * 1.25).toFixed(2)} ms,
+                      latency {peripheral.latency}, timeout{" "}
+                      {peripheral.timeout * 10} ms
+                    </div>
+                  )}
+                  {peripheral.batteryKnown && (
+                    <div className="peripheral-detail">
+                      🔋 {peripheral.batteryLevel}%
+                    </div>
+                  )}
+                  {peripheral.uptimeKnown && (
+                    <div className="peripheral-detail">
+                      Uptime {formatDuration(peripheral.uptimeS)}
+                    </div>
+                  )}
+                  {peripheral.bonded && (
+                    <div className="peripheral-detail">
+                      Reconnects {peripheral.reconnects}
+                      {peripheral.disconnects > 0 && (
+                        <>
+                          , last drop{" "}
+                          {formatDisconnectReason(
+                            peripheral.lastDisconnectReason
+                          )}{" "}
+                          {formatDuration(peripheral.lastDisconnectAgeS)} ago
+                        </>
+                      )}
+                    </div>
+                  )}
+                  {peripheral.connected && (
+                    <button
+                      className="btn btn-secondary peripheral-action"
+                      onClick={() => forgetPeripheralBond(peripheral.slot)}
+                      disabled={isLoading}
+                    >
+                      Forget Bond on Peripheral
+                    </button>
+                  )}
+                </div>
+              ))}
+
             {!splitInfo.isCentral && (
               <div className="info-item">
                 <strong>Central Bonded:</strong>{" "}